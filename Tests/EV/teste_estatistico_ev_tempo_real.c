@@ -81,7 +81,7 @@ void run_large_scale_simulation() {
         // Criar shoe para esta simulação
         Shoe shoe;
         baralho_criar(&shoe);
-        baralho_embaralhar(&shoe);
+        baralho_embaralhar(&shoe, rng_thread_state());
         
         // Distribuir cartas iniciais
         for (int i = 0; i < 2; i++) {
@@ -71,7 +71,7 @@ void* simulate_thread(void* arg) {
         for (int shoe_num = 0; shoe_num < 1000; shoe_num++) {
             Shoe shoe;
             baralho_criar(&shoe);
-            baralho_embaralhar(&shoe);
+            baralho_embaralhar(&shoe, rng_thread_state());
             
             double running_count = 0.0;
             double true_count = 0.0;
@@ -228,7 +228,8 @@ void avaliar_mao_fast(uint64_t bits, Mao *out) {
     out->blackjack = is_blackjack_fast(bits);
     out->aposta = 0.0;
     out->pnl = 0.0;
-    out->hist_len = 0;
-    out->historico[0] = '\0';
     out->resultado = '?';
+    out->split_rank_idx = -1;
+    out->num_acoes = 0;
+    out->fria = NULL;       // histórico de ações fica em MaoFria (jogo.h)
 } 
\ No newline at end of file
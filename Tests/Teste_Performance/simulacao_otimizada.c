@@ -110,7 +110,7 @@ void simulacao_completa_otimizada(int log_level, int sim_id, const char* output_
     while (shoes_jogados < NUM_SHOES) {
         Shoe shoe;
         baralho_criar(&shoe);
-        baralho_embaralhar(&shoe);
+        baralho_embaralhar(&shoe, rng_thread_state());
         
         // Jogar até atingir a penetração
         size_t limite_penetracao = (size_t)(shoe.total * PENETRACAO);
@@ -131,7 +131,7 @@ void simulacao_completa_otimizada(int log_level, int sim_id, const char* output_
             
             // Calcular aposta usando o sistema de progressão
             size_t cartas_restantes = shoe.total - shoe.topo;
-            int bet = definir_aposta(cartas_restantes, vitorias, true_count, maos_jogadas, loss_shoe, unidade_atual);
+            int bet = definir_aposta(cartas_restantes, vitorias, true_count, maos_jogadas, loss_shoe, unidade_atual, NULL);
             
             // Uma rodada completa
             uint64_t *maos_bits = (uint64_t*)calloc(total_maos, sizeof(uint64_t));
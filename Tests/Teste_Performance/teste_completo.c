@@ -320,20 +320,20 @@ void teste_apostas(ResultadoTeste *r) {
     printf("\n=== TESTE 6: SISTEMA DE APOSTAS ===\n");
     
     // Teste aposta mínima
-    int aposta = definir_aposta(500, 10, 0.0, 100, 0.0, 5.0);
+    int aposta = definir_aposta(500, 10, 0.0, 100, 0.0, 5.0, NULL);
     verificar_teste(r, aposta >= 5, "Aposta mínima >= 5");
     
     // Teste com true count alto
-    aposta = definir_aposta(300, 50, 6.0, 100, 0.0, 5.0);
+    aposta = definir_aposta(300, 50, 6.0, 100, 0.0, 5.0, NULL);
     verificar_teste(r, aposta > 5, "Aposta com TC alto > aposta mínima");
     
     // Teste com shoe longo
-    aposta = definir_aposta(450, 10, 3.0, 50, 0.0, 5.0);
+    aposta = definir_aposta(450, 10, 3.0, 50, 0.0, 5.0, NULL);
     verificar_teste(r, aposta == 5, "Shoe longo = aposta mínima");
     
-    printf("   Aposta TC=0: %d\n", definir_aposta(300, 50, 0.0, 100, 0.0, 5.0));
-    printf("   Aposta TC=3: %d\n", definir_aposta(300, 50, 3.0, 100, 0.0, 5.0));
-    printf("   Aposta TC=6: %d\n", definir_aposta(300, 50, 6.0, 100, 0.0, 5.0));
+    printf("   Aposta TC=0: %d\n", definir_aposta(300, 50, 0.0, 100, 0.0, 5.0, NULL));
+    printf("   Aposta TC=3: %d\n", definir_aposta(300, 50, 3.0, 100, 0.0, 5.0, NULL));
+    printf("   Aposta TC=6: %d\n", definir_aposta(300, 50, 6.0, 100, 0.0, 5.0, NULL));
 }
 
 // Teste 7: Verificar mãos contabilizadas
@@ -156,7 +156,7 @@ int main() {
     
     Shoe shoe;
     baralho_criar(&shoe);
-    baralho_embaralhar(&shoe);
+    baralho_embaralhar(&shoe, rng_thread_state());
     
     // Simular algumas rodadas
     for (int rodada = 1; rodada <= 3; rodada++) {
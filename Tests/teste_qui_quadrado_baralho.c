@@ -0,0 +1,110 @@
+#include "baralho.h"
+#include "constantes.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+
+/**
+ * TESTE QUI-QUADRADO DE UNIFORMIDADE POSIÇÃO x RANK
+ *
+ * Para cada posição distribuída do shoe (até a penetração) conta quantas vezes
+ * cada rank apareceu ao longo de N shoes. Num embaralhamento uniforme cada
+ * rank tem probabilidade 1/13 em qualquer posição.
+ *
+ *  1) embaralhamento completo vs. esperado uniforme
+ *  2) embaralhamento sob demanda (lazy) vs. esperado uniforme
+ *  3) homogeneidade lazy vs. completo (tabela 2 x células)
+ *
+ * Com graus de liberdade grandes, X² ~ N(df, 2df): aceita se |z| < 4.
+ */
+
+#define NUM_SHOES_TESTE 20000
+#define Z_LIMITE 4.0
+
+static size_t posicoes_testadas(size_t total) {
+    return (size_t)(total * PENETRACAO);
+}
+
+static void acumular(long *contagem, bool lazy, RngState *rng, Shoe *shoe, size_t posicoes) {
+    for (int s = 0; s < NUM_SHOES_TESTE; ++s) {
+        if (lazy) {
+            baralho_embaralhar_lazy(shoe, rng);
+        } else {
+            baralho_embaralhar(shoe, rng);
+        }
+        for (size_t p = 0; p < posicoes; ++p) {
+            int rank = carta_para_rank_idx(baralho_comprar(shoe));
+            contagem[p * 13 + rank]++;
+        }
+    }
+}
+
+static bool verificar_uniforme(const char *nome, const long *contagem, size_t posicoes) {
+    double esperado = (double)NUM_SHOES_TESTE / 13.0;
+    double x2 = 0.0;
+    for (size_t c = 0; c < posicoes * 13; ++c) {
+        double d = (double)contagem[c] - esperado;
+        x2 += d * d / esperado;
+    }
+    double df = (double)(posicoes * 12);
+    double z = (x2 - df) / sqrt(2.0 * df);
+    bool ok = fabs(z) < Z_LIMITE;
+    printf("%s %s: X²=%.1f df=%.0f z=%.2f\n", ok ? "✓" : "✗", nome, x2, df, z);
+    return ok;
+}
+
+static bool verificar_homogeneidade(const long *a, const long *b, size_t posicoes) {
+    double x2 = 0.0;
+    for (size_t c = 0; c < posicoes * 13; ++c) {
+        double soma = (double)(a[c] + b[c]);
+        if (soma == 0.0) continue;
+        double esperado = soma / 2.0; // mesmo número de shoes nas duas amostras
+        double da = (double)a[c] - esperado;
+        double db = (double)b[c] - esperado;
+        x2 += (da * da + db * db) / esperado;
+    }
+    double df = (double)(posicoes * 12);
+    double z = (x2 - df) / sqrt(2.0 * df);
+    bool ok = fabs(z) < Z_LIMITE;
+    printf("%s lazy vs completo: X²=%.1f df=%.0f z=%.2f\n", ok ? "✓" : "✗", x2, df, z);
+    return ok;
+}
+
+int main(void) {
+    Shoe shoe;
+    baralho_criar(&shoe);
+    size_t posicoes = posicoes_testadas(shoe.total);
+
+    long *completo = (long*)calloc(posicoes * 13, sizeof(long));
+    long *lazy = (long*)calloc(posicoes * 13, sizeof(long));
+    if (!completo || !lazy) {
+        fprintf(stderr, "Erro de alocação\n");
+        return 1;
+    }
+
+    RngState rng;
+    rng_seed(&rng, 12345, 0);
+    acumular(completo, false, &rng, &shoe, posicoes);
+    rng_seed(&rng, 12345, 1);
+    acumular(lazy, true, &rng, &shoe, posicoes);
+
+    printf("Qui-quadrado posição x rank: %d shoes, %zu posições\n", NUM_SHOES_TESTE, posicoes);
+    bool ok = true;
+    ok &= verificar_uniforme("completo", completo, posicoes);
+    ok &= verificar_uniforme("lazy", lazy, posicoes);
+    ok &= verificar_homogeneidade(lazy, completo, posicoes);
+
+    free(completo);
+    free(lazy);
+    baralho_destruir(&shoe);
+
+    if (!ok) {
+        fprintf(stderr, "FALHA: distribuição das posições não é uniforme\n");
+        return 1;
+    }
+    printf("✓ Teste qui-quadrado do baralho passou.\n");
+    return 0;
+}
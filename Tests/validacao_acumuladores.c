@@ -0,0 +1,167 @@
+#include "acumulador_arquivo.h"
+#include "simulacao.h"
+#include "constantes.h"
+#include "tabela_estrategia.h"
+#include "structures.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+// Confere o arquivo de acumuladores (-acum / merge):
+//  - gravar e somar de volta reproduz os contadores exatamente (A + B = soma
+//    das duas execuções, contador a contador);
+//  - arquivo corrompido, truncado ou de outra versão é recusado sem somar nada;
+//  - arquivos de mesas, estratégias ou desvios diferentes não são compatíveis;
+//  - o merge conta as simulações de cada análise separadamente.
+
+// Roda sim_inicio..sim_fim-1 com todas as análises e soma nos totais
+static void simular(int sim_inicio, int sim_fim) {
+    atomic_int log_count = 0;
+    for (int sim = sim_inicio; sim < sim_fim; ++sim) {
+        simulacao_completa(0, sim, NULL, &log_count, true, true, true, true, true, false, true, 42, false);
+    }
+    simulacao_freq_acumular_thread();
+    simulacao_split_acumular_thread();
+    simulacao_as_acumular_thread();
+}
+
+static uint64_t* exportar(size_t n) {
+    uint64_t *v = (uint64_t*)malloc(n * sizeof(uint64_t));
+    if (!v) {
+        perror("malloc");
+        exit(1);
+    }
+    simulacao_totais_exportar(v);
+    return v;
+}
+
+static bool iguais(const uint64_t *a, const uint64_t *b, size_t n) {
+    return memcmp(a, b, n * sizeof(uint64_t)) == 0;
+}
+
+// Copia o arquivo aplicando uma alteração: byte invertido na posição, ou truncado nela
+static void copiar_alterado(const char *origem, const char *destino, long posicao, bool truncar) {
+    FILE *in = fopen(origem, "rb");
+    FILE *out = fopen(destino, "wb");
+    if (!in || !out) {
+        perror("fopen");
+        exit(1);
+    }
+    int c;
+    for (long i = 0; (c = fgetc(in)) != EOF; ++i) {
+        if (i == posicao) {
+            if (truncar) break;
+            c ^= 0x01;
+        }
+        fputc(c, out);
+    }
+    fclose(in);
+    fclose(out);
+}
+
+int main(void) {
+    constantes_definir("shoes", "20");
+    estrategia_flat_inicializar();
+
+    char arq_a[256], arq_b[256], arq_ruim[256];
+    snprintf(arq_a, sizeof(arq_a), "/tmp/validacao_acum_%ld_a.bin", (long)getpid());
+    snprintf(arq_b, sizeof(arq_b), "/tmp/validacao_acum_%ld_b.bin", (long)getpid());
+    snprintf(arq_ruim, sizeof(arq_ruim), "/tmp/validacao_acum_%ld_ruim.bin", (long)getpid());
+
+    size_t n = simulacao_totais_num_contadores();
+    const uint32_t todas = ACUM_FREQ_26 | ACUM_FREQ_70 | ACUM_FREQ_A | ACUM_SPLIT | ACUM_DEALER | ACUM_INSURANCE;
+
+    // Execução A (sims 0-3) e, somada a ela, execução B (sims 4-7)
+    simular(0, 4);
+    uint64_t *totais_a = exportar(n);
+    AcumuladorHeader h = acumulador_header_atual(todas, 4, 0, 0);
+    conferir(acumulador_gravar(arq_a, &h) == 0, "gravar arquivo A");
+
+    simular(4, 8);
+    uint64_t *totais_ab = exportar(n);
+    h = acumulador_header_atual(todas, 8, 0, 0);
+    conferir(acumulador_gravar(arq_b, &h) == 0, "gravar arquivo B");
+
+    uint64_t soma_a = 0;
+    size_t nao_nulos = 0;
+    for (size_t i = 0; i < n; ++i) {
+        soma_a += totais_a[i];
+        nao_nulos += totais_a[i] != 0;
+    }
+    AsBin dealer = {0, 0}, insurance = {0, 0};
+    for (int b = 0; b < MAX_BINS; ++b) dealer.ases += simulacao_dealer_bj_bin(b).ases;
+    for (int b = 0; b < INSURANCE_BINS; ++b) insurance.ases += simulacao_insurance_bin(b).ases;
+    conferir(nao_nulos > 1000 && dealer.ases > 0 && insurance.ases > 0, "execução de teste sem dados nas análises");
+
+    // Somar A de volta: totais = (A+B) + A, contador a contador
+    AcumuladorHeader lido;
+    conferir(acumulador_somar_arquivo(arq_a, &lido) == 0, "somar arquivo A");
+    conferir(lido.num_sims == 4 && lido.analises == todas && lido.num_contadores == n &&
+             lido.decks == (uint32_t)DECKS && lido.jogadores == (uint32_t)NUM_JOGADORES &&
+             lido.sims_por_analise[0] == 4 && lido.sims_por_analise[ACUM_NUM_ANALISES - 1] == 4,
+             "cabeçalho lido de A");
+    uint64_t *esperado = exportar(n);
+    for (size_t i = 0; i < n; ++i) esperado[i] = totais_ab[i] + totais_a[i];
+    uint64_t *totais = exportar(n);
+    conferir(iguais(totais, esperado, n), "totais após somar A diferem de (A+B) + A");
+
+    // Arquivos inválidos: nada é somado
+    long tamanho = (long)(sizeof(AcumuladorHeader) + n * sizeof(uint64_t));
+    struct { long posicao; bool truncar; const char *descricao; } casos[] = {
+        { (long)sizeof(AcumuladorHeader) + 8 * 1234 + 3, false, "contador corrompido aceito" },
+        { tamanho - 1, false, "último byte corrompido aceito" },
+        { 0, false, "assinatura corrompida aceita" },
+        { 8, false, "versão diferente aceita" },
+        { tamanho - 8, true, "arquivo truncado aceito" },
+        { 40, true, "cabeçalho truncado aceito" },
+    };
+    for (size_t c = 0; c < sizeof(casos) / sizeof(casos[0]); ++c) {
+        copiar_alterado(arq_b, arq_ruim, casos[c].posicao, casos[c].truncar);
+        conferir(acumulador_somar_arquivo(arq_ruim, NULL) != 0, casos[c].descricao);
+    }
+    simulacao_totais_exportar(totais);
+    conferir(iguais(totais, esperado, n), "arquivo inválido alterou os totais");
+
+    // Mesas diferentes
+    AcumuladorHeader outra = h;
+    conferir(acumulador_compativeis(&h, &outra), "mesma mesa incompatível");
+    outra.decks = h.decks + 1;
+    conferir(!acumulador_compativeis(&h, &outra), "decks diferentes compatíveis");
+    outra = h;
+    outra.penetracao_ppm = h.penetracao_ppm + 1;
+    conferir(!acumulador_compativeis(&h, &outra), "penetração diferente compatível");
+    outra = h;
+    outra.estrategia_hash = 0x1234;
+    conferir(!acumulador_compativeis(&h, &outra), "estratégias diferentes compatíveis");
+    outra = h;
+    outra.desvios_hash = 0x1234;
+    conferir(!acumulador_compativeis(&h, &outra), "desvios diferentes compatíveis");
+
+    // Simulações por análise: execução só com splits somada a uma com todas
+    AcumuladorHeader total = acumulador_header_atual(todas, 8, 0, 0);
+    AcumuladorHeader so_split = acumulador_header_atual(ACUM_SPLIT, 5, 0, 0);
+    acumulador_header_somar(&total, &so_split);
+    conferir(total.num_sims == 13 && total.analises == todas &&
+             total.sims_por_analise[3] == 13 && total.sims_por_analise[0] == 8 &&
+             total.sims_por_analise[5] == 8, "simulações por análise após somar");
+
+    remove(arq_a);
+    remove(arq_b);
+    remove(arq_ruim);
+    free(totais_a);
+    free(totais_ab);
+    free(esperado);
+    free(totais);
+
+    printf("Acumuladores: %zu contadores por arquivo (%zu não nulos em A, %llu eventos)\n",
+           n, nao_nulos, (unsigned long long)soma_a);
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas no arquivo de acumuladores\n", falhas);
+        return 1;
+    }
+    printf("✓ Arquivo de acumuladores: soma exata, validação e compatibilidade conferem.\n");
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 static bool verificar_total_cartas(Shoe *shoe) {
     size_t esperado = (size_t)DECKS * 52;
@@ -17,7 +18,7 @@ static bool verificar_total_cartas(Shoe *shoe) {
 static bool verificar_distribuicao_por_rank(Shoe *shoe) {
     int contagem[13] = {0};
     for (size_t i = 0; i < shoe->total; ++i) {
-        int idx = carta_para_rank_idx(shoe->cartas[i]);
+        int idx = carta_para_rank_idx(baralho_carta(shoe, i));
         if (idx < 0 || idx >= 13) {
             fprintf(stderr, "FALHA: Rank idx fora do intervalo: %d\n", idx);
             return false;
@@ -35,6 +36,30 @@ static bool verificar_distribuicao_por_rank(Shoe *shoe) {
     return ok;
 }
 
+// Kernel AVX2 e fallback escalar: mesma semente, mesmos índices de troca
+static bool verificar_kernels_rng(void) {
+    uint32_t n = (uint32_t)DECKS * 52;
+    uint32_t simd[RNG_SHUFFLE_CAPACITY((uint32_t)DECKS * 52)];
+    uint32_t escalar[RNG_SHUFFLE_CAPACITY((uint32_t)DECKS * 52)];
+    RngState a, b;
+    rng_seed(&a, 12345, 7);
+    rng_seed(&b, 12345, 7);
+    bool ok = true;
+    for (int rodada = 0; rodada < 100 && ok; ++rodada) {
+        rng_forcar_escalar(0);
+        rng_fill_shuffle(&a, simd, n);
+        rng_forcar_escalar(1);
+        rng_fill_shuffle(&b, escalar, n);
+        if (memcmp(simd, escalar, (n - 1) * sizeof(uint32_t)) != 0) {
+            fprintf(stderr, "FALHA: kernel %s e fallback escalar divergem na rodada %d\n",
+                    rng_simd_ativo() ? "AVX2" : "escalar", rodada);
+            ok = false;
+        }
+    }
+    rng_forcar_escalar(0);
+    return ok;
+}
+
 int main(void) {
     rng_init();
     Shoe shoe;
@@ -42,8 +67,9 @@ int main(void) {
 
     bool total_ok = verificar_total_cartas(&shoe);
     bool dist_ok = verificar_distribuicao_por_rank(&shoe);
+    bool rng_ok = verificar_kernels_rng();
 
-    if (total_ok && dist_ok) {
+    if (total_ok && dist_ok && rng_ok) {
         printf("✓ Teste de integridade do baralho passou. Total e distribuição corretos.\n");
         baralho_destruir(&shoe);
         return 0;
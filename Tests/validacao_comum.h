@@ -0,0 +1,53 @@
+#ifndef VALIDACAO_COMUM_H
+#define VALIDACAO_COMUM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Apoio comum aos programas de validação em Tests/. Cada programa é um único
+// .c ligado aos objetos do simulador sem main.o, então este cabeçalho entra
+// uma vez por binário e pode definir o estado global que main.c definiria.
+
+// simulacao.c e get_bin_index_robust usam DEBUG_*; a flag vive em main.c
+bool debug_enabled = false;
+
+// Falhas do teste: o main retorna != 0 se houver alguma
+static long falhas = 0;
+
+static inline void conferir(bool ok, const char *descricao) {
+    if (!ok) {
+        fprintf(stderr, "FALHA: %s\n", descricao);
+        falhas++;
+    }
+}
+
+// xorshift64: sorteios reproduzíveis, os mesmos em toda execução
+static uint64_t semente = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t sortear_u64(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 7;
+    semente ^= semente << 17;
+    return semente;
+}
+
+// 0..n-1 (viés do módulo desprezível para os n dos testes)
+static inline int sortear(int n) {
+    return (int)(sortear_u64() % (uint64_t)n);
+}
+
+// Grava o conteúdo num arquivo temporário e o entrega ao carregador;
+// true se o carregador recusou o arquivo
+static inline bool arquivo_rejeitado(const char *conteudo, bool (*recusa)(const char *caminho)) {
+    const char *caminho = "Tests/arquivo_invalido.tmp";
+    FILE *f = fopen(caminho, "w");
+    if (!f) return false;
+    fputs(conteudo, f);
+    fclose(f);
+    bool rejeitado = recusa(caminho);
+    remove(caminho);
+    return rejeitado;
+}
+
+#endif // VALIDACAO_COMUM_H
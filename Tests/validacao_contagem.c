@@ -0,0 +1,147 @@
+#define _POSIX_C_SOURCE 199309L
+#include "contador_cartas.h"
+#include "baralho.h"
+#include "constantes.h"
+#include "rng.h"
+#include "structures.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+
+// Confere a contagem inteira (Wong Halves x2) do ContadorCartas contra o
+// contador em double de antes (running count em double, true count pelo
+// recíproco e get_bin_index_robust), carta a carta em shoes embaralhados:
+// running count, true count e bin de TC idênticos bit a bit, de modo que as
+// tabelas e CSVs existentes se reproduzem.
+// Ao final mede cartas/s dos dois contadores sobre os mesmos shoes: melhor de
+// REPETICOES passadas alternadas sobre SHOES_BENCHMARK shoes.
+
+#define SHOES_BENCHMARK 20000
+#define REPETICOES 7
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Contador de antes da contagem inteira: running count em double, true count
+// pelo recíproco e get_bin_index_robust por carta
+__attribute__((noinline))
+static long passada_double(ContadorCartas *cc, const uint8_t *ranks, int num_shoes, int total) {
+    long acc = 0;
+    for (int s = 0; s < num_shoes; ++s) {
+        const uint8_t *shoe = ranks + (size_t)s * total;
+        contador_cartas_iniciar(cc, DECKS, (size_t)total);
+        double running_count = 0.0;
+        for (int i = 0; i < total; ++i) {
+            int rank_idx = shoe[i];
+            cc->shoe.counts[rank_idx]--;
+            cc->shoe.total_cards--;
+            running_count += WONG_HALVES[rank_idx];
+            cc->true_count = running_count * cc->inv_baralhos[total - i - 1];
+            acc += get_bin_index_robust(cc->true_count);
+        }
+    }
+    return acc;
+}
+
+__attribute__((noinline))
+static long passada_inteira(ContadorCartas *cc, const uint8_t *ranks, int num_shoes, int total) {
+    long acc = 0;
+    for (int s = 0; s < num_shoes; ++s) {
+        const uint8_t *shoe = ranks + (size_t)s * total;
+        contador_cartas_iniciar(cc, DECKS, (size_t)total);
+        for (int i = 0; i < total; ++i) {
+            contador_cartas_registrar(cc, shoe[i], (size_t)(total - i - 1));
+            acc += contador_cartas_bin_tc(cc);
+        }
+    }
+    return acc;
+}
+
+int main(void) {
+    int total = DECKS * 52;
+
+    // As duas tabelas de Halves (double e x2 inteira) descrevem a mesma contagem
+    for (int r = 0; r < 13; ++r) {
+        if (WONG_HALVES[r] * 2.0 != (double)WONG_HALVES_X2[r]) {
+            fprintf(stderr, "FALHA: WONG_HALVES[%d] = %.1f, WONG_HALVES_X2[%d] = %d\n", r, WONG_HALVES[r], r, WONG_HALVES_X2[r]);
+            falhas++;
+        }
+    }
+
+    ContadorCartas cc;
+
+    // Shoes embaralhados: contador incremental contra a contagem em double
+    rng_init();
+    RngState *rng = rng_thread_state();
+    Shoe shoe;
+    baralho_criar(&shoe);
+    uint8_t *ranks = (uint8_t*)malloc((size_t)SHOES_BENCHMARK * total);
+    if (!ranks) {
+        perror("malloc");
+        return 1;
+    }
+    for (int s = 0; s < SHOES_BENCHMARK; ++s) {
+        baralho_embaralhar(&shoe, rng);
+        uint8_t *destino = ranks + (size_t)s * total;
+        for (int i = 0; i < total; ++i) destino[i] = (uint8_t)carta_para_rank_idx(baralho_carta(&shoe, (size_t)i));
+    }
+    baralho_destruir(&shoe);
+
+    // Mesma sequência, conferida carta a carta (primeiros 2000 shoes)
+    long cartas_conferidas = 0;
+    for (int s = 0; s < 2000; ++s) {
+        const uint8_t *cartas_shoe = ranks + (size_t)s * total;
+        contador_cartas_iniciar(&cc, DECKS, (size_t)total);
+        double running_count = 0.0;
+        for (int i = 0; i < total; ++i) {
+            contador_cartas_registrar(&cc, cartas_shoe[i], (size_t)(total - i - 1));
+            running_count += WONG_HALVES[cartas_shoe[i]];
+            double true_count = running_count * cc.inv_baralhos[total - i - 1];
+            cartas_conferidas++;
+            if (contador_cartas_running_count(&cc) != running_count ||
+                memcmp(&cc.true_count, &true_count, sizeof(double)) != 0 ||
+                contador_cartas_bin_tc(&cc) != get_bin_index_robust(true_count)) {
+                if (falhas < 10) fprintf(stderr, "FALHA: shoe %d carta %d: RC %.1f/%.1f, TC %.17g/%.17g\n",
+                                         s, i, contador_cartas_running_count(&cc), running_count, cc.true_count, true_count);
+                falhas++;
+            }
+        }
+    }
+
+    printf("Contagem: %ld cartas conferidas contra o contador em double\n", cartas_conferidas);
+
+    // Benchmark: as duas passadas somam os mesmos bins
+    double t_double = INFINITY, t_inteiro = INFINITY;
+    long soma_double = 0, soma_inteiro = 0;
+    for (int rep = 0; rep < REPETICOES; ++rep) {
+        double t0 = agora_s();
+        soma_double = passada_double(&cc, ranks, SHOES_BENCHMARK, total);
+        double t1 = agora_s();
+        soma_inteiro = passada_inteira(&cc, ranks, SHOES_BENCHMARK, total);
+        double t2 = agora_s();
+        if (t1 - t0 < t_double) t_double = t1 - t0;
+        if (t2 - t1 < t_inteiro) t_inteiro = t2 - t1;
+    }
+    conferir(soma_double == soma_inteiro, "contadores em double e inteiro somam bins diferentes");
+    free(ranks);
+    contador_cartas_liberar_thread();
+
+    double cartas = (double)SHOES_BENCHMARK * total;
+    printf("Benchmark (%d shoes, %.0f cartas, melhor de %d): contador em double %.1f Mcartas/s, "
+           "contador inteiro %.1f Mcartas/s (%.2fx)\n", SHOES_BENCHMARK, cartas, REPETICOES,
+           cartas / t_double * 1e-6, cartas / t_inteiro * 1e-6, t_double / t_inteiro);
+
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas na contagem inteira\n", falhas);
+        return 1;
+    }
+    printf("✓ Contagem inteira confere bit a bit com a contagem em double (true count e bin de TC).\n");
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "desvios.h"
+#include "fsm_mao.h"
+#include "tabela_estrategia.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Confere as tabelas de desvios por true count: regras de
+// Estrategias/desvios_i18.txt nos dois lados do limite, estratégia básica
+// nas células sem regra, contadores de acerto e rejeição de arquivos
+// inválidos.
+
+// Estado de uma mão de duas cartas (índices de rank 0..12)
+static uint16_t mao2(int rank_a, int rank_b) {
+    return fsm_proximo(fsm_proximo(FSM_ESTADO_VAZIO, rank_a), rank_b);
+}
+
+static void conferir_acao(const char *nome, uint16_t estado, int upcard, double tc, AcaoEstrategia esperada) {
+    AcaoEstrategia obtida = desvios_acao(estado, upcard, tc);
+    if (obtida != esperada) {
+        fprintf(stderr, "FALHA: %s vs %d com TC %.2f: ação %d, esperada %d\n", nome, upcard, tc, obtida, esperada);
+        falhas++;
+    }
+}
+
+static bool desvios_recusados(const char *caminho) {
+    return desvios_carregar_arquivo(caminho) != 0;
+}
+
+int main(void) {
+    if (desvios_carregar_arquivo("Estrategias/desvios_i18.txt") != 0) {
+        fprintf(stderr, "FALHA: não foi possível carregar Estrategias/desvios_i18.txt\n");
+        return 1;
+    }
+    if (!desvios_ativos()) {
+        fprintf(stderr, "FALHA: desvios carregados mas inativos\n");
+        return 1;
+    }
+
+    // Índices de rank: 2..9 = 0..7, T = 8, J = 9, A = 12
+    uint16_t hard16 = mao2(8, 4);   // T,6
+    uint16_t hard16_3 = fsm_proximo(mao2(3, 5), 2); // 5,7,4: hard 16 com 3 cartas
+    uint16_t hard12 = mao2(8, 0);   // T,2
+    uint16_t par_t = mao2(8, 8);    // T,T
+    uint16_t t_j = mao2(8, 9);      // T,J: 20 hard, não é par
+    uint16_t par_8 = mao2(6, 6);    // 8,8: par, não hard 16
+
+    conferir_acao("16", hard16, 10, -0.01, ACAO_HIT);
+    conferir_acao("16", hard16, 10, 0.0, ACAO_STAND);
+    conferir_acao("16 (3 cartas)", hard16_3, 10, 0.5, ACAO_STAND);
+    conferir_acao("8,8", par_8, 10, 3.0, estrategia_basica_estado(par_8, 10));
+    conferir_acao("12", hard12, 4, -0.5, ACAO_HIT);
+    conferir_acao("12", hard12, 4, 0.0, ACAO_STAND);
+    conferir_acao("12", hard12, 2, 2.99, ACAO_HIT);
+    conferir_acao("12", hard12, 2, 3.0, ACAO_STAND);
+    conferir_acao("T,T", par_t, 6, 3.9, ACAO_STAND);
+    conferir_acao("T,T", par_t, 6, 4.0, ACAO_SPLIT);
+    conferir_acao("T,T", par_t, 6, 50.0, ACAO_SPLIT);   // saturado na última faixa
+    conferir_acao("T,T", par_t, 6, -50.0, ACAO_STAND);  // saturado na primeira faixa
+    conferir_acao("T,J", t_j, 6, 8.0, ACAO_STAND);
+
+    // Células sem regra: igual à estratégia básica em todas as faixas
+    for (int estado = 0; estado < FSM_NUM_ESTADOS; ++estado) {
+        int valor;
+        ClasseEstrategia classe = estrategia_classe_estado((uint16_t)estado, &valor);
+        for (int up = 2; up <= 11; ++up) {
+            if (classe == CLASSE_HARD && (valor == 9 || valor == 10 || valor == 12 || valor == 13 ||
+                                          valor == 15 || valor == 16)) continue;
+            if (classe == CLASSE_PAR && valor == 10) continue;
+            for (int tc = DESVIO_TC_MIN - 2; tc <= DESVIO_TC_MAX + 2; ++tc) {
+                if (desvios_acao((uint16_t)estado, up, tc) != estrategia_basica_estado((uint16_t)estado, up)) {
+                    fprintf(stderr, "FALHA: estado %d vs %d com TC %d difere da estratégia básica\n", estado, up, tc);
+                    falhas++;
+                }
+            }
+        }
+    }
+
+    // Contadores: 3 consultas de 16 vs 10 com TC >= 0 (regra 0) nesta thread
+    desvios_acumular_thread();
+    uint64_t antes = desvios_acertos(0);
+    for (int i = 0; i < 3; ++i) desvios_acao(hard16, 10, 1.0);
+    desvios_acao(hard16, 10, -1.0);
+    desvios_acumular_thread();
+    if (desvios_acertos(0) - antes != 3) {
+        fprintf(stderr, "FALHA: regra 0 contou %llu acertos, esperado 3\n",
+                (unsigned long long)(desvios_acertos(0) - antes));
+        falhas++;
+    }
+
+    desvios_set_habilitados(false);
+    if (desvios_ativos()) {
+        fprintf(stderr, "FALHA: desvios ativos após desvios_set_habilitados(false)\n");
+        falhas++;
+    }
+
+    const char *invalidos[] = {
+        "hard 22 10 >= 0 S\n",
+        "soft 12 5 >= 1 DH\n",
+        "par 1 5 >= 5 P\n",
+        "hard 16 1 >= 0 S\n",
+        "hard 16 10 > 0 S\n",
+        "hard 16 10 >= 0.5 S\n",
+        "hard 16 10 >= 40 S\n",
+        "hard 16 10 >= 0 X\n",
+        "hard 16 10 >= 0\n",
+        "hard 16 10 >= 0 S extra\n",
+        "hard 16 10 >= 0 P\n",
+        "soft 18 6 >= 2 PS\n",
+    };
+    for (size_t i = 0; i < sizeof(invalidos) / sizeof(invalidos[0]); ++i) {
+        if (!arquivo_rejeitado(invalidos[i], desvios_recusados)) {
+            fprintf(stderr, "FALHA: regra inválida aceita: %s", invalidos[i]);
+            falhas++;
+        }
+    }
+
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas nas tabelas de desvios\n", falhas);
+        return 1;
+    }
+    printf("✓ Tabelas de desvios por true count conferem.\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "estrategia_arquivo.h"
+#include "tabela_estrategia.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Confere o carregamento de estratégias em arquivo: Estrategias/basica.txt
+// compila para a mesma tabela da estratégia embutida, o cache binário é
+// reaproveitado (e recompilado se corrompido), a troca por thread funciona
+// e arquivos inválidos são rejeitados.
+
+static bool tabelas_iguais(const uint8_t (*a)[10], const uint8_t (*b)[10]) {
+    return memcmp(a, b, (size_t)estrategia_num_estados() * 10) == 0;
+}
+
+static void caminho_cache(const EstrategiaCompilada *e, char *saida, size_t tamanho) {
+    snprintf(saida, tamanho, "Estrategias/.cache/%016llx.bin", (unsigned long long)estrategia_hash(e));
+}
+
+static bool estrategia_recusada(const char *caminho) {
+    return estrategia_carregar(caminho) == NULL;
+}
+
+// Conteúdo de basica.txt com a linha que começa por 'prefixo' trocada
+static char *basica_com_linha(const char *prefixo, const char *nova) {
+    FILE *f = fopen("Estrategias/basica.txt", "r");
+    if (!f) return NULL;
+    char *saida = (char*)calloc(1, 16384);
+    char linha[256];
+    while (saida && fgets(linha, sizeof(linha), f)) {
+        strcat(saida, strncmp(linha, prefixo, strlen(prefixo)) == 0 ? nova : linha);
+    }
+    fclose(f);
+    return saida;
+}
+
+int main(void) {
+    estrategia_flat_inicializar();
+    int n = estrategia_num_estados();
+    uint8_t (*embutida)[10] = malloc((size_t)n * 10);
+    TabelasEstrategia tabelas;
+    estrategia_tabelas_embutidas(&tabelas);
+    estrategia_compilar(&tabelas, embutida);
+
+    const EstrategiaCompilada *basica = estrategia_carregar("Estrategias/basica.txt");
+    if (!basica) {
+        fprintf(stderr, "FALHA: não foi possível carregar Estrategias/basica.txt\n");
+        return 1;
+    }
+    conferir(tabelas_iguais(estrategia_tabela(basica), (const uint8_t (*)[10])embutida),
+             "basica.txt difere da estratégia embutida");
+    conferir(estrategia_carregar("Estrategias/basica.txt") == basica,
+             "mesmo conteúdo carregado duas vezes não reaproveitou a estratégia");
+
+    // Processo novo (registro vazio): a tabela vem do cache binário
+    estrategia_descarregar_todas();
+    basica = estrategia_carregar("Estrategias/basica.txt");
+    conferir(basica && estrategia_do_cache(basica), "segunda carga de basica.txt não veio do cache");
+    conferir(basica && tabelas_iguais(estrategia_tabela(basica), (const uint8_t (*)[10])embutida),
+             "tabela lida do cache difere da estratégia embutida");
+
+    // Cache corrompido (truncado): recompila do texto e regrava
+    char cache[256];
+    caminho_cache(basica, cache, sizeof(cache));
+    FILE *f = fopen(cache, "r+b");
+    if (f) {
+        fclose(f);
+        f = fopen(cache, "wb");
+        fputs("BJEST001", f);
+        fclose(f);
+    }
+    estrategia_descarregar_todas();
+    basica = estrategia_carregar("Estrategias/basica.txt");
+    conferir(basica && !estrategia_do_cache(basica) &&
+             tabelas_iguais(estrategia_tabela(basica), (const uint8_t (*)[10])embutida),
+             "cache corrompido não foi recompilado corretamente");
+
+    // Troca por thread: pares agressivos dividem 2,2 contra 9; a básica pede hit
+    const EstrategiaCompilada *pares = estrategia_carregar("Estrategias/pares_agressivos.txt");
+    conferir(pares != NULL, "não foi possível carregar Estrategias/pares_agressivos.txt");
+    if (pares) {
+        int estado_par2 = -1;
+        for (int e = 0; e < n && estado_par2 < 0; ++e) {
+            int valor;
+            if (estrategia_classe_estado((uint16_t)e, &valor) == CLASSE_PAR && valor == 2) estado_par2 = e;
+        }
+        conferir(estrategia_basica_estado((uint16_t)estado_par2, 9) == ACAO_HIT, "2,2 vs 9 na básica deveria ser H");
+        estrategia_set_thread(estrategia_tabela(pares));
+        conferir(estrategia_basica_estado((uint16_t)estado_par2, 9) == ACAO_SPLIT_OR_HIT, "2,2 vs 9 com pares agressivos deveria ser PH");
+        estrategia_set_thread(NULL);
+        conferir(estrategia_basica_estado((uint16_t)estado_par2, 9) == ACAO_HIT, "estrategia_set_thread(NULL) não voltou à padrão");
+
+        // Só as linhas de par diferem
+        for (int e = 0; e < n; ++e) {
+            int valor;
+            if (estrategia_classe_estado((uint16_t)e, &valor) == CLASSE_PAR) continue;
+            if (memcmp(estrategia_tabela(pares)[e], embutida[e], 10) != 0) {
+                conferir(false, "pares_agressivos.txt difere da básica fora dos pares");
+                break;
+            }
+        }
+    }
+
+    struct { const char *prefixo, *linha; } invalidas[] = {
+        {"hard 16", ""},                                          // linha faltando
+        {"hard 16", "hard 16   S  S  S  S  S  H  H  H  P  H\n"},  // split em hard
+        {"soft 18", "soft 18   S  DS DS DS DS S  S  H  H  X\n"},  // ação inválida
+        {"hard 16", "hard 15   S  S  S  S  S  H  H  H  H  H\n"},  // 15 repetido, 16 faltando
+        {"par  A",  "par  A    PS PS PS PS PS PS PS PS PS PS PS\n"}, // 11 ações
+        {"par  A",  "par  1    PS PS PS PS PS PS PS PS PS PS\n"},    // carta inválida
+    };
+    for (size_t i = 0; i < sizeof(invalidas) / sizeof(invalidas[0]); ++i) {
+        char *conteudo = basica_com_linha(invalidas[i].prefixo, invalidas[i].linha);
+        if (!conteudo || !arquivo_rejeitado(conteudo, estrategia_recusada)) {
+            fprintf(stderr, "FALHA: arquivo inválido aceito (caso %zu)\n", i);
+            falhas++;
+        }
+        free(conteudo);
+    }
+
+    estrategia_descarregar_todas();
+    free(embutida);
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas nas estratégias em arquivo\n", falhas);
+        return 1;
+    }
+    printf("✓ Estratégias em arquivo: compilação, cache e troca por thread conferem.\n");
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "jogo.h"
+#include "fsm_mao.h"
+#include "tabela_estrategia.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Confere o autômato gerado contra calcular_valor_mao/tipo_mao para toda
+// mão alcançável: cada multiconjunto de cartas ainda não estourado (até 15
+// cartas por rank, limite do campo de 4 bits) e cada carta seguinte. Os
+// kernels SWAR de mao_bits.h são conferidos contra a contagem explícita.
+// Também confere a tabela plana de estratégia indexada pelo estado.
+
+static long maos_verificadas = 0;
+static long falhas = 0;
+
+static uint16_t estado_em_ordem(const int contagem[13], bool crescente) {
+    uint16_t estado = FSM_ESTADO_VAZIO;
+    for (int i = 0; i < 13; ++i) {
+        int rank = crescente ? i : 12 - i;
+        for (int k = 0; k < contagem[rank]; ++k) {
+            estado = fsm_proximo(estado, rank);
+        }
+    }
+    return estado;
+}
+
+static uint64_t bits_de(const int contagem[13]) {
+    uint64_t bits = 0;
+    for (int rank = 0; rank < 13; ++rank) {
+        bits += (uint64_t)contagem[rank] * mao_bits_carta(rank);
+    }
+    return bits;
+}
+
+static int total_duro(const int contagem[13]) {
+    static const int valor[13] = {2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 1};
+    int total = 0;
+    for (int rank = 0; rank < 13; ++rank) total += contagem[rank] * valor[rank];
+    return total;
+}
+
+static bool conferir(uint16_t estado, uint64_t bits) {
+    const FsmAtributos *a = fsm_atributos(estado);
+    int valor = calcular_valor_mao(bits);
+    TipoMao tipo = tipo_mao(bits);
+    int num_cartas = mao_bits_num_cartas(bits);
+    bool ok = a->valor == valor && a->tipo == (uint8_t)tipo &&
+              a->num_cartas == (num_cartas < 3 ? num_cartas : 3) &&
+              a->par_rank == mao_bits_par_rank_idx(bits) &&
+              !!(a->flags & FSM_SOFT) == mao_bits_soft(bits) &&
+              !!(a->flags & FSM_BUST) == (valor > 21) &&
+              !!(a->flags & FSM_DEALER_PARA) == (valor >= 17) &&
+              !!(a->flags & FSM_BLACKJACK) == (tipo == MAO_BLACKJACK);
+    maos_verificadas++;
+    if (!ok) {
+        if (falhas < 10) {
+            fprintf(stderr, "FALHA: bits=%llx estado=%u valor %d/%d tipo %d/%d flags=0x%02x\n",
+                    (unsigned long long)bits, estado, a->valor, valor, a->tipo, tipo, a->flags);
+        }
+        falhas++;
+    }
+    return ok;
+}
+
+// Enumera multiconjuntos com ranks >= rank_min (cada um visitado uma vez)
+static void enumerar(int contagem[13], int rank_min, uint16_t estado) {
+    // Mão atual (não estourada): conferir o estado e a ordem inversa
+    uint64_t bits = bits_de(contagem);
+    conferir(estado, bits);
+    if (mao_bits_total_duro(bits) != total_duro(contagem)) {
+        if (falhas < 10) fprintf(stderr, "FALHA: total duro SWAR %d, esperado %d (bits=%llx)\n",
+                                 mao_bits_total_duro(bits), total_duro(contagem), (unsigned long long)bits);
+        falhas++;
+    }
+    if (estado_em_ordem(contagem, false) != estado) {
+        if (falhas < 10) fprintf(stderr, "FALHA: estado depende da ordem das cartas (bits=%llx)\n", (unsigned long long)bits);
+        falhas++;
+    }
+
+    // Próxima carta de qualquer rank: inclui as mãos que estouram
+    for (int rank = 0; rank < 13; ++rank) {
+        if (contagem[rank] >= MAO_MAX_POR_RANK) continue;
+        contagem[rank]++;
+        uint16_t prox = fsm_proximo(estado, rank);
+        if (total_duro(contagem) > 21) {
+            conferir(prox, bits_de(contagem));
+        } else if (rank >= rank_min) {
+            enumerar(contagem, rank, prox);
+        }
+        contagem[rank]--;
+    }
+}
+
+int main(void) {
+    int contagem[13] = {0};
+    enumerar(contagem, 0, FSM_ESTADO_VAZIO);
+
+    printf("Autômato de mãos: %d estados, %ld mãos verificadas\n", FSM_NUM_ESTADOS, maos_verificadas);
+    if (falhas > 0) {
+        fprintf(stderr, "%ld divergências entre o autômato e calcular_valor_mao/tipo_mao\n", falhas);
+        return 1;
+    }
+    printf("✓ Autômato de mãos confere com calcular_valor_mao/tipo_mao.\n");
+
+    // Tabela plana de estratégia (estado x dealer) contra estrategia_basica_super_rapida
+    long maos_estrategia = 0;
+    long divergencias = estrategia_flat_validar(&maos_estrategia);
+    printf("Tabela plana de estratégia: %ld mãos x 10 upcards verificadas\n", maos_estrategia);
+    if (divergencias > 0) {
+        fprintf(stderr, "%ld divergências entre a tabela plana e estrategia_basica_super_rapida\n", divergencias);
+        return 1;
+    }
+    printf("✓ Tabela plana confere com estrategia_basica_super_rapida.\n");
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "jogo.h"
+#include "liquidacao.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Confere a liquidação em lote (liquidar_maos, AVX2 quando disponível)
+// contra verificar_mao + calcular_pnl em rodadas aleatórias: mãos de
+// jogador e dealer sorteadas carta a carta, com BJ, doubles, splits e
+// estouros, de 1 a 40 mãos por rodada (lotes de 8 e sobra escalar).
+
+#define RODADAS 200000
+#define MAX_MAOS 40
+
+static uint64_t adicionar(uint64_t bits, int rank) {
+    return bits + mao_bits_carta(rank);
+}
+
+// Duas cartas e compra até o alvo (alvo 0: fica com duas cartas)
+static void sortear_mao(Mao *m, int alvo) {
+    uint64_t bits = adicionar(adicionar(0, sortear(13)), sortear(13));
+    avaliar_mao(bits, m);
+    while (m->valor < alvo) {
+        bits = adicionar(bits, sortear(13));
+        avaliar_mao(bits, m);
+    }
+}
+
+int main(void) {
+    static Mao jogadores[MAX_MAOS];
+    int32_t valor[MAX_MAOS], resultado[MAX_MAOS], resultado_esc[MAX_MAOS];
+    uint32_t flags[MAX_MAOS];
+    double aposta[MAX_MAOS], pnl[MAX_MAOS], pnl_esc[MAX_MAOS];
+    long maos = 0;
+
+    for (int rodada = 0; rodada < RODADAS; ++rodada) {
+        Mao dealer;
+        sortear_mao(&dealer, 17);
+        int n = 1 + sortear(MAX_MAOS);
+        for (int i = 0; i < n; ++i) {
+            Mao *m = &jogadores[i];
+            sortear_mao(m, sortear(4) == 0 ? 0 : 12 + sortear(10));
+            if (sortear(8) == 0) {   // mão de split: 21 com duas cartas não é BJ
+                m->from_split = true;
+                m->blackjack = false;
+            }
+            m->isdouble = !m->blackjack && sortear(5) == 0;
+            m->aposta = 1 + sortear(500);
+            valor[i] = m->valor;
+            flags[i] = (m->blackjack ? LIQ_BLACKJACK : 0u) | (m->isdouble ? LIQ_DOUBLE : 0u) |
+                       (m->valor > 21 ? LIQ_BUST : 0u);
+            aposta[i] = m->aposta;
+        }
+        uint32_t dealer_flags = (dealer.blackjack ? LIQ_BLACKJACK : 0u) | (dealer.valor > 21 ? LIQ_BUST : 0u);
+        liquidar_maos(n, valor, flags, aposta, dealer.valor, dealer_flags, resultado, pnl);
+        liquidar_maos_escalar(n, valor, flags, aposta, dealer.valor, dealer_flags, resultado_esc, pnl_esc);
+
+        for (int i = 0; i < n; ++i) {
+            Mao *m = &jogadores[i];
+            verificar_mao(m, &dealer);
+            calcular_pnl(m);
+            char obtido = "DEV"[resultado[i] + 1];
+            maos++;
+            if (obtido != m->resultado || pnl[i] != m->pnl ||
+                resultado_esc[i] != resultado[i] || pnl_esc[i] != pnl[i]) {
+                if (falhas < 10) {
+                    fprintf(stderr, "FALHA: jogador %d (flags 0x%x) vs dealer %d (flags 0x%x): %c/%.1f, esperado %c/%.1f\n",
+                            m->valor, flags[i], dealer.valor, dealer_flags, obtido, pnl[i], m->resultado, m->pnl);
+                }
+                falhas++;
+            }
+        }
+    }
+
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas em %ld mãos liquidadas\n", falhas, maos);
+        return 1;
+    }
+    printf("✓ Liquidação em lote confere com verificar_mao/calcular_pnl (%ld mãos).\n", maos);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#define _POSIX_C_SOURCE 199309L
+#include "simulacao.h"
+#include "baralho.h"
+#include "constantes.h"
+#include "tabela_estrategia.h"
+#include "structures.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Confere o núcleo enxuto de simulacao_completa (sem análises, log nem EV,
+// com esses testes eliminados na compilação):
+//  - é selecionado só quando todas as flags estão desligadas, e nunca com
+//    simulacao_set_nucleo_completo(true);
+//  - joga exatamente as mesmas rodadas que o núcleo completo: mesmas rodadas,
+//    mesmo total de unidades bit a bit, mesmos mínimo e máximo por simulação,
+//    numa mesa especializada e numa mesa do caminho genérico.
+// Mede também rodadas/s dos dois núcleos sobre as mesmas simulações
+// (melhor de REPETICOES execuções alternadas).
+
+#define REPETICOES 7
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Roda as simulações sem análises com o núcleo pedido; devolve as unidades e o tempo
+static UnidadesThread simular(int num_sims, bool completo, double *segundos) {
+    atomic_int log_count = 0;
+    simulacao_set_nucleo_completo(completo);
+    double t0 = agora_s();
+    for (int sim = 0; sim < num_sims; ++sim) {
+        simulacao_completa(0, sim, NULL, &log_count, false, false, false, false, false, false, false, 42, false);
+    }
+    *segundos = agora_s() - t0;
+    simulacao_set_nucleo_completo(false);
+    UnidadesThread u;
+    simulacao_unidades_coletar_thread(&u);
+    return u;
+}
+
+static void comparar_mesa(const char *decks, const char *jogadores, int num_sims) {
+    constantes_definir("decks", decks);
+    constantes_definir("jogadores", jogadores);
+    baralho_liberar_thread(); // o shoe da thread é recriado com os novos baralhos
+    double t_enxuto, t_completo, descarte;
+
+    // Aquecimento: shoe e arenas da thread alocados antes da medição
+    simular(2, false, &descarte);
+    simular(2, true, &descarte);
+
+    UnidadesThread enxuto = simular(num_sims, false, &t_enxuto);
+    UnidadesThread completo = simular(num_sims, true, &t_completo);
+    // Repetições alternadas; vale o melhor tempo de cada núcleo
+    for (int r = 1; r < REPETICOES; ++r) {
+        double t;
+        simular(num_sims, false, &t);
+        if (t < t_enxuto) t_enxuto = t;
+        simular(num_sims, true, &t);
+        if (t < t_completo) t_completo = t;
+    }
+
+    char descricao[128];
+    double v_enxuto = soma_compensada_valor(&enxuto.total), v_completo = soma_compensada_valor(&completo.total);
+    snprintf(descricao, sizeof(descricao), "%s baralhos, %s jogadores: núcleos divergem", decks, jogadores);
+    conferir(enxuto.rodadas > 0 && enxuto.rodadas == completo.rodadas &&
+             enxuto.por_sim.n == completo.por_sim.n &&
+             memcmp(&v_enxuto, &v_completo, sizeof(double)) == 0 &&
+             enxuto.minimo_sim == completo.minimo_sim && enxuto.maximo_sim == completo.maximo_sim,
+             descricao);
+
+    printf("Benchmark (%s baralhos, %s jogadores, %s, %llu rodadas): completo %.0f rodadas/s, enxuto %.0f rodadas/s (%.2fx)\n",
+           decks, jogadores, simulacao_especializada() ? "laço especializado" : "laço genérico",
+           (unsigned long long)enxuto.rodadas, completo.rodadas / t_completo, enxuto.rodadas / t_enxuto,
+           t_completo / t_enxuto);
+}
+
+int main(void) {
+    constantes_definir("shoes", "20");
+    estrategia_flat_inicializar();
+
+    // Seleção do núcleo
+    conferir(simulacao_nucleo_enxuto(0, false, false, false, false, false, false, false), "sem flags: núcleo enxuto não selecionado");
+    conferir(!simulacao_nucleo_enxuto(10, false, false, false, false, false, false, false), "log ativo com núcleo enxuto");
+    conferir(!simulacao_nucleo_enxuto(0, true, false, false, false, false, false, false), "-dealer com núcleo enxuto");
+    conferir(!simulacao_nucleo_enxuto(0, false, false, true, false, false, false, false), "-hist70 com núcleo enxuto");
+    conferir(!simulacao_nucleo_enxuto(0, false, false, false, false, true, false, false), "-split com núcleo enxuto");
+    conferir(!simulacao_nucleo_enxuto(0, false, false, false, false, false, true, false), "-ev com núcleo enxuto");
+    conferir(!simulacao_nucleo_enxuto(0, false, false, false, false, false, false, true), "-ins com núcleo enxuto");
+    simulacao_set_nucleo_completo(true);
+    conferir(!simulacao_nucleo_enxuto(0, false, false, false, false, false, false, false), "-full-kernel ignorado");
+    simulacao_set_nucleo_completo(false);
+
+    // Mesma execução nos dois núcleos: mesa especializada e caminho genérico
+    comparar_mesa("8", "7", 1000);
+    comparar_mesa("2", "3", 1000);
+
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas nos núcleos de simulação\n", falhas);
+        return 1;
+    }
+    printf("✓ Núcleo enxuto selecionado só sem análises e idêntico ao núcleo completo.\n");
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "estatistica_online.h"
+#include "simulacao.h"
+#include "structures.h"
+#include "validacao_comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+// Confere a soma compensada das unidades (compilada com as flags do
+// simulador, -ffast-math incluso) contra uma referência em __float128:
+//  - 10^7 parcelas de 0.1, onde a soma ingênua perde ~4 dígitos;
+//  - resultados de rodada sorteados em blocos de tamanhos variados, como
+//    simulações repartidas entre threads e combinadas após o join: o total
+//    fica a 1 ulp da referência qualquer que seja a partição;
+//  - unidades_combinar preserva n, média, variância, mínimo e máximo.
+
+static double sortear_rodada(void) {
+    uint64_t x = sortear_u64();
+    // PnL de rodada em unidades: de -8 a +8 com passos de 0.25, escala da unidade variável
+    double unidades = (double)((int)(x % 65) - 32) * 0.25;
+    return unidades / (1.0 + (double)((x >> 20) % 7));
+}
+
+static bool perto(double valor, __float128 referencia, double ulps) {
+    double ref = (double)referencia;
+    return fabs(valor - ref) <= ulps * (nextafter(fabs(ref), INFINITY) - fabs(ref));
+}
+
+int main(void) {
+    semente = 0x2545F4914F6CDD1DULL;
+
+    // 10^7 x 0.1
+    SomaCompensada s = {0.0, 0.0};
+    double ingenua = 0.0;
+    __float128 referencia = 0;
+    for (int i = 0; i < 10000000; ++i) {
+        soma_compensada_adicionar(&s, 0.1);
+        ingenua += 0.1;
+        referencia += (__float128)0.1;
+    }
+    printf("10^7 x 0.1: compensada %.17g, ingênua %.17g, referência %.17Lg\n",
+           soma_compensada_valor(&s), ingenua, (long double)referencia);
+    if (!perto(soma_compensada_valor(&s), referencia, 1.0)) {
+        fprintf(stderr, "FALHA: soma compensada de 10^7 x 0.1 fora de 1 ulp\n");
+        falhas++;
+    }
+
+    // Rodadas repartidas em "simulações" e "threads" de tamanhos variados
+    enum { RODADAS = 2000000, PARTICOES = 5 };
+    double *rodadas = (double*)malloc(RODADAS * sizeof(double));
+    if (!rodadas) return 1;
+    referencia = 0;
+    for (int i = 0; i < RODADAS; ++i) {
+        rodadas[i] = sortear_rodada();
+        referencia += (__float128)rodadas[i];
+    }
+    const int num_threads[PARTICOES] = {1, 2, 3, 7, 32};
+    double totais[PARTICOES];
+    UnidadesThread combinado[PARTICOES];
+    for (int p = 0; p < PARTICOES; ++p) {
+        int threads = num_threads[p];
+        UnidadesThread *por_thread = (UnidadesThread*)calloc((size_t)threads, sizeof(UnidadesThread));
+        if (!por_thread) return 1;
+        // Simulações de 997 rodadas, distribuídas em blocos contíguos como em main.c
+        const int rodadas_sim = 997;
+        int num_sims = (RODADAS + rodadas_sim - 1) / rodadas_sim;
+        for (int sim = 0; sim < num_sims; ++sim) {
+            int t = (int)((long)sim * threads / num_sims);
+            SomaCompensada unidades_sim = {0.0, 0.0};
+            for (int r = sim * rodadas_sim; r < RODADAS && r < (sim + 1) * rodadas_sim; ++r) {
+                soma_compensada_adicionar(&unidades_sim, rodadas[r]);
+            }
+            UnidadesThread uma = {0};
+            double v = soma_compensada_valor(&unidades_sim);
+            uma.total.soma = v;
+            uma.minimo_sim = uma.maximo_sim = v;
+            estatistica_adicionar(&uma.por_sim, v);
+            unidades_combinar(&por_thread[t], &uma);
+        }
+        UnidadesThread total = {0};
+        for (int t = 0; t < threads; ++t) {
+            unidades_combinar(&total, &por_thread[t]);
+        }
+        totais[p] = soma_compensada_valor(&total.total);
+        combinado[p] = total;
+        free(por_thread);
+        if (!perto(totais[p], referencia, 1.0)) {
+            fprintf(stderr, "FALHA: %d threads: total %.17g, referência %.17Lg\n", threads, totais[p], (long double)referencia);
+            falhas++;
+        }
+    }
+    for (int p = 1; p < PARTICOES; ++p) {
+        const UnidadesThread *a = &combinado[0], *b = &combinado[p];
+        double var_a = estatistica_variancia(&a->por_sim), var_b = estatistica_variancia(&b->por_sim);
+        if (a->por_sim.n != b->por_sim.n || a->minimo_sim != b->minimo_sim || a->maximo_sim != b->maximo_sim ||
+            fabs(a->por_sim.media - b->por_sim.media) > 1e-12 * (1.0 + fabs(a->por_sim.media)) ||
+            fabs(var_a - var_b) > 1e-9 * var_a) {
+            fprintf(stderr, "FALHA: distribuição por simulação com %d threads difere de 1 thread\n", num_threads[p]);
+            falhas++;
+        }
+    }
+    printf("Rodadas sorteadas: referência %.17Lg; totais com 1/2/3/7/32 threads: %.17g %.17g %.17g %.17g %.17g\n",
+           (long double)referencia, totais[0], totais[1], totais[2], totais[3], totais[4]);
+    free(rodadas);
+
+    if (falhas > 0) {
+        fprintf(stderr, "%ld falhas na soma das unidades\n", falhas);
+        return 1;
+    }
+    printf("✓ Soma compensada das unidades confere com a referência em qualquer partição entre threads.\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+#define _DEFAULT_SOURCE
+#include "acumulador_arquivo.h"
+#include "simulacao.h"
+#include "constantes.h"
+#include "structures.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <math.h>
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIMO  0x100000001b3ULL
+
+static uint64_t fnv1a(uint64_t hash, const void *dados, size_t n) {
+    const uint8_t *p = (const uint8_t*)dados;
+    for (size_t i = 0; i < n; ++i) {
+        hash ^= p[i];
+        hash *= FNV_PRIMO;
+    }
+    return hash;
+}
+
+AcumuladorHeader acumulador_header_atual(uint32_t analises, uint64_t num_sims,
+                                         uint64_t estrategia_hash, uint64_t desvios_hash) {
+    AcumuladorHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, ACUMULADOR_MAGIC, sizeof(h.magic));
+    h.versao = ACUMULADOR_VERSAO;
+    h.analises = analises;
+    h.decks = (uint32_t)DECKS;
+    h.jogadores = (uint32_t)NUM_JOGADORES;
+    h.penetracao_ppm = (uint32_t)lround(PENETRACAO * 1e6);
+    h.max_bins = MAX_BINS;
+    h.num_sims = num_sims;
+    h.num_contadores = simulacao_totais_num_contadores();
+    h.estrategia_hash = estrategia_hash;
+    h.desvios_hash = desvios_hash;
+    for (int a = 0; a < ACUM_NUM_ANALISES; ++a) {
+        if (analises & (1u << a)) h.sims_por_analise[a] = num_sims;
+    }
+    return h;
+}
+
+bool acumulador_compativeis(const AcumuladorHeader *a, const AcumuladorHeader *b) {
+    return a->decks == b->decks && a->jogadores == b->jogadores &&
+           a->penetracao_ppm == b->penetracao_ppm &&
+           a->estrategia_hash == b->estrategia_hash && a->desvios_hash == b->desvios_hash;
+}
+
+void acumulador_header_somar(AcumuladorHeader *a, const AcumuladorHeader *b) {
+    a->analises |= b->analises;
+    a->num_sims += b->num_sims;
+    for (int i = 0; i < ACUM_NUM_ANALISES; ++i) a->sims_por_analise[i] += b->sims_por_analise[i];
+}
+
+int acumulador_gravar(const char *caminho, const AcumuladorHeader *header) {
+    size_t n = simulacao_totais_num_contadores();
+    uint64_t *contadores = (uint64_t*)malloc(n * sizeof(uint64_t));
+    if (!contadores) {
+        fprintf(stderr, "Erro ao alocar acumuladores (%zu contadores)\n", n);
+        return -1;
+    }
+    simulacao_totais_exportar(contadores);
+
+    AcumuladorHeader cab = *header;
+    cab.num_contadores = n;
+    cab.checksum = fnv1a(FNV_OFFSET, contadores, n * sizeof(uint64_t));
+
+    // Grava em arquivo temporário e renomeia: um merge concorrente nunca lê arquivo parcial
+    char temporario[1100];
+    snprintf(temporario, sizeof(temporario), "%s.%ld.tmp", caminho, (long)getpid());
+    FILE *f = fopen(temporario, "wb");
+    if (!f) {
+        fprintf(stderr, "Erro ao criar arquivo de acumuladores %s: %s\n", temporario, strerror(errno));
+        free(contadores);
+        return -1;
+    }
+    bool ok = fwrite(&cab, sizeof(cab), 1, f) == 1 && fwrite(contadores, sizeof(uint64_t), n, f) == n;
+    ok = (fclose(f) == 0) && ok;
+    free(contadores);
+    if (!ok || rename(temporario, caminho) != 0) {
+        fprintf(stderr, "Erro ao gravar arquivo de acumuladores %s\n", caminho);
+        remove(temporario);
+        return -1;
+    }
+    return 0;
+}
+
+int acumulador_somar_arquivo(const char *caminho, AcumuladorHeader *header_lido) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        fprintf(stderr, "Erro ao abrir arquivo de acumuladores %s: %s\n", caminho, strerror(errno));
+        return -1;
+    }
+
+    AcumuladorHeader cab;
+    size_t n = simulacao_totais_num_contadores();
+    uint64_t *contadores = NULL;
+    const char *erro = NULL;
+    if (fread(&cab, sizeof(cab), 1, f) != 1) {
+        erro = "arquivo truncado";
+    } else if (memcmp(cab.magic, ACUMULADOR_MAGIC, sizeof(cab.magic)) != 0) {
+        erro = "assinatura inválida";
+    } else if (cab.versao != ACUMULADOR_VERSAO) {
+        erro = "versão não suportada";
+    } else if (cab.max_bins != MAX_BINS || cab.num_contadores != n) {
+        erro = "layout dos contadores diferente da build atual";
+    } else if (!(contadores = (uint64_t*)malloc(n * sizeof(uint64_t)))) {
+        erro = "memória insuficiente";
+    } else if (fread(contadores, sizeof(uint64_t), n, f) != n || fgetc(f) != EOF) {
+        erro = "tamanho diferente do indicado no cabeçalho";
+    } else if (fnv1a(FNV_OFFSET, contadores, n * sizeof(uint64_t)) != cab.checksum) {
+        erro = "checksum não confere";
+    }
+    fclose(f);
+
+    if (erro) {
+        fprintf(stderr, "Arquivo de acumuladores %s inválido: %s\n", caminho, erro);
+        free(contadores);
+        return -1;
+    }
+
+    simulacao_totais_somar(contadores);
+    free(contadores);
+    if (header_lido) *header_lido = cab;
+    return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef ACUMULADOR_ARQUIVO_H
+#define ACUMULADOR_ARQUIVO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Arquivo de acumuladores (-acum): contadores brutos de todas as análises
+// (simulacao_totais_exportar), em vez das frequências derivadas dos CSVs.
+// Vários arquivos da mesma mesa somam exatamente: o subcomando merge soma
+// quantos forem e regenera os CSVs (e com eles as tabelas de lookup), de
+// modo que a amostra cresce entre execuções e máquinas sem re-simular.
+//
+// Cabeçalho fixo de 128 bytes seguido de num_contadores uint64 little-endian,
+// conferidos por FNV-1a. O cabeçalho identifica também a estratégia e os
+// desvios jogados: o merge só soma arquivos da mesma mesa jogados da mesma
+// forma, e conta as simulações de cada análise separadamente.
+
+#define ACUMULADOR_MAGIC "BJACUM01"
+#define ACUMULADOR_VERSAO 2
+
+// Análises cujos CSVs o arquivo alimenta (máscara em AcumuladorHeader.analises)
+#define ACUM_FREQ_26   (1u << 0)
+#define ACUM_FREQ_70   (1u << 1)
+#define ACUM_FREQ_A    (1u << 2)
+#define ACUM_SPLIT     (1u << 3)
+#define ACUM_DEALER    (1u << 4)
+#define ACUM_INSURANCE (1u << 5)
+#define ACUM_NUM_ANALISES 6
+
+typedef struct {
+    char magic[8];
+    uint32_t versao;
+    uint32_t analises;          // máscara ACUM_*
+    uint32_t decks;
+    uint32_t jogadores;
+    uint32_t penetracao_ppm;    // penetração em partes por milhão
+    uint32_t max_bins;          // bins de TC das seções
+    uint64_t num_sims;          // simulações somadas no arquivo
+    uint64_t num_contadores;    // uint64 após o cabeçalho
+    uint64_t checksum;          // FNV-1a dos contadores
+    uint64_t estrategia_hash;   // estrategia_hash() de -estrategia; 0 = tabela embutida
+    uint64_t desvios_hash;      // desvios_hash(); 0 = sem desvios ativos
+    uint64_t sims_por_analise[ACUM_NUM_ANALISES]; // simulações por bit ACUM_*
+    uint8_t reservado[8];       // cabeçalho com 128 bytes
+} AcumuladorHeader;
+
+_Static_assert(sizeof(AcumuladorHeader) == 128, "cabeçalho do arquivo de acumuladores deve ter 128 bytes");
+
+// Cabeçalho com as regras da mesa atual (DECKS, NUM_JOGADORES, PENETRACAO)
+// e a estratégia/desvios jogados; num_sims conta em cada análise presente
+AcumuladorHeader acumulador_header_atual(uint32_t analises, uint64_t num_sims,
+                                         uint64_t estrategia_hash, uint64_t desvios_hash);
+
+// Grava os totais do processo (arquivo temporário + rename). 0 = ok.
+int acumulador_gravar(const char *caminho, const AcumuladorHeader *header);
+
+// Valida o arquivo e soma seus contadores nos totais do processo; o
+// cabeçalho lido vai em header_lido. 0 = ok; em erro nada é somado.
+int acumulador_somar_arquivo(const char *caminho, AcumuladorHeader *header_lido);
+
+// true se os dois arquivos vêm da mesma mesa, com a mesma estratégia e os
+// mesmos desvios, e podem ser somados
+bool acumulador_compativeis(const AcumuladorHeader *a, const AcumuladorHeader *b);
+
+// Soma o arquivo b em a: análises, simulações e simulações por análise
+void acumulador_header_somar(AcumuladorHeader *a, const AcumuladorHeader *b);
+
+#endif // ACUMULADOR_ARQUIVO_H
@@ -6,62 +6,124 @@
 
 static const char RANK_CHARS[13] = {'2','3','4','5','6','7','8','9','T','J','Q','K','A'};
 
-// Codifica o rank para o padrão de 39 bits: grupo de 3 bits por rank
-static Carta encode_rank(int idx) {
-    return (Carta)1ULL << (idx * 3);
-}
+// Padrão de 52 bits de cada rank: campo de 4 bits por rank (mao_bits.h)
+const Carta CARTA_POR_RANK[13] = {
+    1ULL << 0,  1ULL << 4,  1ULL << 8,  1ULL << 12, 1ULL << 16,
+    1ULL << 20, 1ULL << 24, 1ULL << 28, 1ULL << 32, 1ULL << 36,
+    1ULL << 40, 1ULL << 44, 1ULL << 48
+};
 
 void baralho_criar(Shoe *shoe) {
     shoe->total = (size_t)DECKS * 52;
-    shoe->cartas = (Carta*)malloc(sizeof(Carta) * shoe->total);
+    shoe->cartas = (uint8_t*)malloc(shoe->total);
     if (!shoe->cartas) {
         perror("malloc");
         exit(EXIT_FAILURE);
     }
-    shoe->topo = 0;
+    shoe->rng_lazy = NULL;
+    shoe->compras_sem_carta = 0;
+    baralho_reiniciar(shoe);
+}
 
+Carta baralho_comprar_sem_carta(Shoe *shoe) {
+    return CARTA_POR_RANK[shoe->compras_sem_carta++ % 13];
+}
+
+// Restaura a ordem canônica (sem realocar). Necessário para que o resultado
+// de uma simulação não dependa do que a thread jogou antes dela.
+void baralho_reiniciar(Shoe *shoe) {
     size_t pos = 0;
     for (int d = 0; d < DECKS; ++d) {
-        for (int rank = 0; rank < 13; ++rank) {
-            Carta c = encode_rank(rank);
+        for (uint8_t rank = 0; rank < 13; ++rank) {
             for (int suit = 0; suit < 4; ++suit) {
-                shoe->cartas[pos++] = c;
+                shoe->cartas[pos++] = rank;
             }
         }
     }
+    shoe->topo = 0;
+}
+
+// Buffer de índices do embaralhamento, um por thread (reaproveitado entre shoes)
+static __thread uint32_t *indices_thread = NULL;
+static __thread size_t indices_capacidade = 0;
+
+static uint32_t *obter_indices(size_t total) {
+    size_t necessario = RNG_SHUFFLE_CAPACITY(total);
+    if (necessario > indices_capacidade) {
+        uint32_t *novo = (uint32_t*)realloc(indices_thread, sizeof(uint32_t) * necessario);
+        if (!novo) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+        indices_thread = novo;
+        indices_capacidade = necessario;
+    }
+    return indices_thread;
+}
+
+static __thread Shoe shoe_thread;
+static __thread int shoe_thread_criado = 0;
+
+Shoe *baralho_thread_shoe(void) {
+    if (!shoe_thread_criado) {
+        baralho_criar(&shoe_thread);
+        shoe_thread_criado = 1;
+    }
+    return &shoe_thread;
+}
+
+void baralho_liberar_thread(void) {
+    if (shoe_thread_criado) {
+        baralho_destruir(&shoe_thread);
+        shoe_thread_criado = 0;
+    }
+    free(indices_thread);
+    indices_thread = NULL;
+    indices_capacidade = 0;
 }
 
-void baralho_embaralhar(Shoe *shoe) {
-    for (size_t i = shoe->total - 1; i > 0; --i) {
-        size_t j = rng_range((uint32_t)(i + 1));
-        Carta tmp = shoe->cartas[i];
+void baralho_embaralhar(Shoe *shoe, RngState *rng) {
+    shoe->rng_lazy = NULL;
+    if (shoe->total < 2) {
+        shoe->topo = 0;
+        return;
+    }
+
+    // Todos os índices do Fisher-Yates gerados em bloco (AVX2 quando disponível)
+    uint32_t *indices = obter_indices(shoe->total);
+    rng_fill_shuffle(rng, indices, (uint32_t)shoe->total);
+
+    size_t k = 0;
+    for (size_t i = shoe->total - 1; i > 0; --i, ++k) {
+        size_t j = indices[k];
+        uint8_t tmp = shoe->cartas[i];
         shoe->cartas[i] = shoe->cartas[j];
         shoe->cartas[j] = tmp;
     }
     shoe->topo = 0; // reiniciar topo após embaralhar
 }
 
-Carta baralho_comprar(Shoe *shoe) {
-    if (shoe->topo >= shoe->total) {
-        fprintf(stderr, "Shoe vazio!\n");
-        exit(EXIT_FAILURE);
-    }
-    return shoe->cartas[shoe->topo++];
+// Adia o embaralhamento para as compras. A ordem distribuída tem a mesma
+// distribuição de um embaralhamento completo (Fisher-Yates ascendente).
+void baralho_embaralhar_lazy(Shoe *shoe, RngState *rng) {
+    shoe->rng_lazy = rng;
+    shoe->topo = 0;
 }
 
 void baralho_destruir(Shoe *shoe) {
     free(shoe->cartas);
     shoe->cartas = NULL;
+    shoe->rng_lazy = NULL;
     shoe->total = shoe->topo = 0;
 }
 
 char carta_para_char(Carta c) {
 #if defined(__GNUC__)
-    int idx = __builtin_ctzll(c) / 3;
+    int idx = __builtin_ctzll(c) / MAO_BITS_POR_RANK;
 #else
     int idx = 0;
-    while ((c & 0x7ULL) == 0) {
-        c >>= 3;
+    while ((c & MAO_CAMPO) == 0) {
+        c >>= MAO_BITS_POR_RANK;
         ++idx;
     }
 #endif
@@ -70,11 +132,11 @@ char carta_para_char(Carta c) {
 
 int carta_para_rank_idx(Carta c) {
 #if defined(__GNUC__)
-    return __builtin_ctzll(c) / 3;
+    return __builtin_ctzll(c) / MAO_BITS_POR_RANK;
 #else
     int idx = 0;
-    while ((c & 0x7ULL) == 0) {
-        c >>= 3;
+    while ((c & MAO_CAMPO) == 0) {
+        c >>= MAO_BITS_POR_RANK;
         ++idx;
     }
     return idx;
@@ -3,19 +3,64 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "rng.h"
+#include "mao_bits.h"        // Campos de 4 bits por rank
 
-typedef uint64_t Carta; // Representação de 39 bits
+typedef uint64_t Carta; // Representação de 52 bits (mao_bits.h)
 
+// Cartas guardadas como índice de rank (0..12 = 2..A), 1 byte cada:
+// um shoe de 8 baralhos ocupa 416 B e cabe na L1. A Carta de 52 bits
+// é obtida na compra via CARTA_POR_RANK.
+// Com rng_lazy != NULL o shoe está em modo preguiçoso: cada compra faz um
+// passo do Fisher-Yates ascendente, sorteando a carta da posição topo entre
+// as restantes. Só as cartas efetivamente distribuídas são embaralhadas.
+// Compras com o shoe já vazio não abortam: devolvem cartas substitutas e
+// contam em compras_sem_carta; a simulação anula a rodada e encerra o shoe.
 typedef struct {
-    Carta *cartas;
+    uint8_t *cartas;
     size_t total;
     size_t topo;
+    RngState *rng_lazy;
+    uint32_t compras_sem_carta;
 } Shoe;
 
+extern const Carta CARTA_POR_RANK[13];
+
 void baralho_criar(Shoe *shoe);
-void baralho_embaralhar(Shoe *shoe);
-Carta baralho_comprar(Shoe *shoe);
+void baralho_reiniciar(Shoe *shoe);
+void baralho_embaralhar(Shoe *shoe, RngState *rng);
+void baralho_embaralhar_lazy(Shoe *shoe, RngState *rng);
 void baralho_destruir(Shoe *shoe);
+
+// Shoe persistente da thread: alocado uma única vez e reembaralhado no lugar
+Shoe *baralho_thread_shoe(void);
+// Libera o shoe e o buffer de índices da thread (chamar antes da thread terminar)
+void baralho_liberar_thread(void);
+
+// Carta na posição pos do shoe (sem consumir)
+static inline Carta baralho_carta(const Shoe *shoe, size_t pos) {
+    return CARTA_POR_RANK[shoe->cartas[pos]];
+}
+
+// Carta substituta para uma compra com o shoe vazio (ranks em sequência,
+// sem formar pares seguidos que levem a splits sem fim); só termina a rodada
+Carta baralho_comprar_sem_carta(Shoe *shoe);
+
+static inline Carta baralho_comprar(Shoe *shoe) {
+    if (__builtin_expect(shoe->topo >= shoe->total, 0)) {
+        return baralho_comprar_sem_carta(shoe);
+    }
+    if (shoe->rng_lazy) {
+        size_t j = shoe->topo + rng_next_range(shoe->rng_lazy, (uint32_t)(shoe->total - shoe->topo));
+        uint8_t tmp = shoe->cartas[shoe->topo];
+        shoe->cartas[shoe->topo] = shoe->cartas[j];
+        shoe->cartas[j] = tmp;
+    }
+    return CARTA_POR_RANK[shoe->cartas[shoe->topo++]];
+}
+
 char carta_para_char(Carta c);
 int carta_para_rank_idx(Carta c);
 
@@ -0,0 +1,182 @@
+#define _POSIX_C_SOURCE 200809L
+#include "comparacao_pareada.h"
+#include "simulacao.h"
+#include "constantes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define Z_95 1.959963984540054
+
+static int parse_variante(const char *texto, VarianteCRN *v) {
+    memset(v, 0, sizeof(*v));
+    snprintf(v->nome, sizeof(v->nome), "%s", texto);
+    rampa_apostas_padrao(&v->rampa);
+
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "%s", texto);
+
+    char *salvo = NULL;
+    char *parte = strtok_r(buffer, ":", &salvo);
+    if (!parte) return -1;
+
+    if (strcmp(parte, "bs") == 0) {
+        v->ev_realtime = false;
+    } else if (strcmp(parte, "ev") == 0) {
+        v->ev_realtime = true;
+    } else {
+        fprintf(stderr, "Erro: estratégia '%s' inválida em -crn (use bs ou ev)\n", parte);
+        return -1;
+    }
+
+    while ((parte = strtok_r(NULL, ":", &salvo)) != NULL) {
+        char *fim = NULL;
+        if (strncmp(parte, "pct=", 4) == 0) {
+            double fator = strtod(parte + 4, &fim);
+            if (!fim || *fim != '\0' || fator <= 0.0) {
+                fprintf(stderr, "Erro: fator pct inválido em -crn: %s\n", parte);
+                return -1;
+            }
+            for (int i = 0; i < 12; ++i) v->rampa.min_pct[i] *= fator;
+        } else if (strncmp(parte, "base=", 5) == 0) {
+            double fator = strtod(parte + 5, &fim);
+            if (!fim || *fim != '\0' || fator <= 0.0) {
+                fprintf(stderr, "Erro: fator base inválido em -crn: %s\n", parte);
+                return -1;
+            }
+            for (int i = 0; i < 12; ++i) v->rampa.apostas_base[i] *= fator;
+        } else if (strncmp(parte, "est=", 4) == 0) {
+            v->estrategia = estrategia_carregar(parte + 4);
+            if (!v->estrategia) return -1;
+        } else {
+            fprintf(stderr, "Erro: parâmetro '%s' inválido em -crn (use pct=X, base=Y ou est=arq)\n", parte);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int crn_parse_variantes(const char *spec, ComparacaoPareada *crn) {
+    memset(crn, 0, sizeof(*crn));
+
+    char buffer[4096];
+    if (strlen(spec) >= sizeof(buffer)) {
+        fprintf(stderr, "Erro: especificação -crn muito longa\n");
+        return -1;
+    }
+    snprintf(buffer, sizeof(buffer), "%s", spec);
+
+    char *salvo = NULL;
+    for (char *item = strtok_r(buffer, ",", &salvo); item; item = strtok_r(NULL, ",", &salvo)) {
+        if (crn->num_variantes >= CRN_MAX_VARIANTES) {
+            fprintf(stderr, "Erro: máximo de %d variantes em -crn\n", CRN_MAX_VARIANTES);
+            return -1;
+        }
+        if (parse_variante(item, &crn->variantes[crn->num_variantes]) != 0) {
+            return -1;
+        }
+        crn->num_variantes++;
+    }
+
+    if (crn->num_variantes < 2) {
+        fprintf(stderr, "Erro: -crn requer pelo menos duas variantes (ex.: bs,ev)\n");
+        return -1;
+    }
+    return 0;
+}
+
+bool crn_usa_ev(const ComparacaoPareada *crn) {
+    for (int v = 0; v < crn->num_variantes; ++v) {
+        if (crn->variantes[v].ev_realtime) return true;
+    }
+    return false;
+}
+
+int crn_iniciar(ComparacaoPareada *crn, int num_threads) {
+    crn->num_threads = num_threads;
+    crn->por_thread = (AcumuladorCRN*)aligned_alloc(64, sizeof(AcumuladorCRN) * (size_t)num_threads);
+    if (!crn->por_thread) return -1;
+    memset(crn->por_thread, 0, sizeof(AcumuladorCRN) * (size_t)num_threads);
+
+    for (int t = 0; t < num_threads; ++t) {
+        for (int v = 0; v < crn->num_variantes; ++v) {
+            crn->por_thread[t].unidades[v] = (double*)calloc((size_t)NUM_SHOES, sizeof(double));
+            if (!crn->por_thread[t].unidades[v]) return -1;
+        }
+    }
+    return 0;
+}
+
+void crn_liberar(ComparacaoPareada *crn) {
+    if (!crn->por_thread) return;
+    for (int t = 0; t < crn->num_threads; ++t) {
+        for (int v = 0; v < crn->num_variantes; ++v) {
+            free(crn->por_thread[t].unidades[v]);
+        }
+    }
+    free(crn->por_thread);
+    crn->por_thread = NULL;
+}
+
+void crn_executar_simulacao(ComparacaoPareada *crn, int thread_id, int sim_id, atomic_int *global_log_count, uint64_t rng_seed_base) {
+    AcumuladorCRN *acc = &crn->por_thread[thread_id];
+
+    // Mesma semente e sim_id em todas as variantes = mesmos shoes.
+    // Análises e logs ficam desligados para não misturar as variantes.
+    for (int v = 0; v < crn->num_variantes; ++v) {
+        const VarianteCRN *var = &crn->variantes[v];
+        simulacao_set_variante(&var->rampa, acc->unidades[v]);
+        estrategia_set_thread(var->estrategia ? estrategia_tabela(var->estrategia) : NULL);
+        simulacao_completa(0, sim_id, NULL, global_log_count, false, false, false, false, false,
+                           var->ev_realtime, false, rng_seed_base, false);
+    }
+    simulacao_set_variante(NULL, NULL);
+    estrategia_set_thread(NULL);
+
+    for (int s = 0; s < NUM_SHOES; ++s) {
+        double base = acc->unidades[0][s];
+        estatistica_adicionar(&acc->valores[0], base);
+        for (int v = 1; v < crn->num_variantes; ++v) {
+            estatistica_adicionar(&acc->valores[v], acc->unidades[v][s]);
+            estatistica_adicionar(&acc->diferencas[v], acc->unidades[v][s] - base);
+        }
+    }
+}
+
+void crn_imprimir_relatorio(const ComparacaoPareada *crn) {
+    EstatisticaOnline valores[CRN_MAX_VARIANTES];
+    EstatisticaOnline diferencas[CRN_MAX_VARIANTES];
+    memset(valores, 0, sizeof(valores));
+    memset(diferencas, 0, sizeof(diferencas));
+
+    for (int t = 0; t < crn->num_threads; ++t) {
+        for (int v = 0; v < crn->num_variantes; ++v) {
+            estatistica_combinar(&valores[v], &crn->por_thread[t].valores[v]);
+            estatistica_combinar(&diferencas[v], &crn->por_thread[t].diferencas[v]);
+        }
+    }
+
+    printf("Comparação pareada (CRN): %llu shoes por variante\n", (unsigned long long)valores[0].n);
+    for (int v = 0; v < crn->num_variantes; ++v) {
+        printf("  [%d] %-20s média %+.4f u/shoe  DP %.4f\n", v, crn->variantes[v].nome,
+               valores[v].media, sqrt(estatistica_variancia(&valores[v])));
+    }
+
+    printf("  Diferença por shoe vs [0] (IC 95%%):\n");
+    for (int v = 1; v < crn->num_variantes; ++v) {
+        const EstatisticaOnline *d = &diferencas[v];
+        double var_d = estatistica_variancia(d);
+        double ep = (d->n > 0) ? sqrt(var_d / (double)d->n) : 0.0;
+        double z = (ep > 0.0) ? d->media / ep : 0.0;
+
+        // Variância da diferença se as variantes fossem simuladas de forma
+        // independente: var(A) + var(B). A razão é o fator de economia de shoes.
+        double var_indep = estatistica_variancia(&valores[0]) + estatistica_variancia(&valores[v]);
+        double reducao = (var_d > 0.0) ? var_indep / var_d : 0.0;
+
+        printf("  [%d]-[0]: Δ=%+.4f u/shoe  EP=%.4f  IC95%%=[%+.4f, %+.4f]  z=%+.2f%s  redução de variância %.1fx\n",
+               v, d->media, ep, d->media - Z_95 * ep, d->media + Z_95 * ep, z,
+               fabs(z) >= Z_95 ? " (significativo)" : "", reducao);
+    }
+}
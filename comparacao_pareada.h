@@ -0,0 +1,54 @@
+#ifndef COMPARACAO_PAREADA_H
+#define COMPARACAO_PAREADA_H
+
+#include "jogo.h"
+#include "estrategia_arquivo.h"
+#include "estatistica_online.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Modo pareado com números aleatórios comuns (CRN): cada configuração joga
+// exatamente os mesmos shoes de cada (sim_id, shoe_idx) e a diferença de
+// resultado é medida shoe a shoe contra a variante base (a primeira).
+
+#define CRN_MAX_VARIANTES 32
+
+typedef struct {
+    char nome[96];              // especificação original, ex.: "bs:pct=1.1"
+    bool ev_realtime;           // ev = EV em tempo real, bs = estratégia básica
+    RampaApostas rampa;
+    const EstrategiaCompilada *estrategia; // est=<arq>; NULL = estratégia padrão
+} VarianteCRN;
+
+typedef struct {
+    EstatisticaOnline valores[CRN_MAX_VARIANTES];     // unidades por shoe de cada variante
+    EstatisticaOnline diferencas[CRN_MAX_VARIANTES];  // variante v - variante 0
+    double *unidades[CRN_MAX_VARIANTES];              // buffer de uma simulação (NUM_SHOES)
+    char padding[64];
+} __attribute__((aligned(64))) AcumuladorCRN;
+
+typedef struct {
+    VarianteCRN variantes[CRN_MAX_VARIANTES];
+    int num_variantes;
+    AcumuladorCRN *por_thread;
+    int num_threads;
+} ComparacaoPareada;
+
+// Lê "bs|ev[:pct=X][:base=Y][:est=arq],..." (pct/base multiplicam
+// MIN_PCT/APOSTAS_BASE; est carrega uma estratégia básica em arquivo, trocada
+// por thread a cada variante sem parsing).
+// Retorna 0 em sucesso; em erro imprime a causa e retorna -1.
+int crn_parse_variantes(const char *spec, ComparacaoPareada *crn);
+bool crn_usa_ev(const ComparacaoPareada *crn);
+
+int crn_iniciar(ComparacaoPareada *crn, int num_threads);
+void crn_liberar(ComparacaoPareada *crn);
+
+// Joga todas as variantes da simulação sim_id na thread thread_id
+void crn_executar_simulacao(ComparacaoPareada *crn, int thread_id, int sim_id, atomic_int *global_log_count, uint64_t rng_seed_base);
+
+// Combina os acumuladores das threads e imprime diferença, EP e IC95% por shoe
+void crn_imprimir_relatorio(const ComparacaoPareada *crn);
+
+#endif // COMPARACAO_PAREADA_H
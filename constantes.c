@@ -1,11 +1,16 @@
+#define _POSIX_C_SOURCE 200809L
 #include "constantes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 
-// Definições das constantes globais
-const int NUM_JOGADORES = 4;
-const int DECKS = 8;
-const double PENETRACAO = 0.5; 
+// Definições das constantes globais (regras da mesa configuráveis)
+int NUM_JOGADORES = 4;
+int DECKS = 8;
+double PENETRACAO = 0.5; 
 const double UNIDADE = 1.0;
-const int NUM_SHOES = 1000;
+int NUM_SHOES = 1000;
 const int NUM_SIMS = 1000;
 const char* OUT_DIR = "/mnt/dados/BJ_Binario/Resultados";
 const double WONG_HALVES[13] = {
@@ -23,6 +28,22 @@ const double WONG_HALVES[13] = {
     -1.0, // K
     -1.0  // A
 };
+// Wong Halves x2 (valores inteiros): 2 = +0.5, 3 = +1, 5 = +1.5, 9 = -0.5 ...
+const int8_t WONG_HALVES_X2[13] = {
+    1,   // 2
+    2,   // 3
+    2,   // 4
+    3,   // 5
+    2,   // 6
+    1,   // 7
+    0,   // 8
+    -1,  // 9
+    -2,  // 10
+    -2,  // J
+    -2,  // Q
+    -2,  // K
+    -2   // A
+};
 
 // Constantes para sistema de apostas
 const double BANKROLL_INICIAL = 7500.0;
@@ -31,6 +52,8 @@ const double UNIDADE_INICIAL = 5.0;
 const double MIN_COUNT_INS = 3.4;
 const double TEN_perc = 0.335;  
 
+// Limites em cartas restantes de um shoe de 8 baralhos (416 cartas), assim
+// como MIN_LEN_SHOE; definir_aposta escala as cartas restantes para outro DECKS
 const int CARTAS_RESTANTES_LIMITE = 412;
 const int CARTAS_RESTANTES_SHOE_OK = 296;
 
@@ -64,6 +87,85 @@ const double APOSTAS_BASE[12] = {
     35.00, 25.00, 17.00, 16.00, 12.00, 12.00, 12.00, 5.00, 4.00, 3.00, 2.00, 1.00
 };
 
-// Variável global para acumular unidades totais (protegida por mutex)
-double unidades_total_global = 0.0;
-pthread_mutex_t unidades_mutex = PTHREAD_MUTEX_INITIALIZER;
\ No newline at end of file
+static int ler_inteiro(const char *chave, const char *valor, int minimo, int maximo, int *destino) {
+    char *fim = NULL;
+    long v = strtol(valor, &fim, 10);
+    if (!fim || fim == valor || *fim != '\0' || v < minimo || v > maximo) {
+        fprintf(stderr, "Erro: valor inválido para %s: %s (esperado %d a %d)\n", chave, valor, minimo, maximo);
+        return -1;
+    }
+    *destino = (int)v;
+    return 0;
+}
+
+int constantes_definir(const char *chave, const char *valor) {
+    if (strcmp(chave, "decks") == 0) {
+        // Até 16 baralhos (o corpus de shoes grava cada shoe em até 512 bytes)
+        return ler_inteiro(chave, valor, 1, 16, &DECKS);
+    } else if (strcmp(chave, "jogadores") == 0) {
+        return ler_inteiro(chave, valor, 1, 7, &NUM_JOGADORES);
+    } else if (strcmp(chave, "shoes") == 0) {
+        return ler_inteiro(chave, valor, 1, 1000000, &NUM_SHOES);
+    } else if (strcmp(chave, "penetracao") == 0) {
+        char *fim = NULL;
+        double v = strtod(valor, &fim);
+        if (!fim || fim == valor || *fim != '\0' || v <= 0.0 || v >= 1.0) {
+            fprintf(stderr, "Erro: valor inválido para penetracao: %s (esperado entre 0 e 1)\n", valor);
+            return -1;
+        }
+        PENETRACAO = v;
+        return 0;
+    } else if (strcmp(chave, "out_dir") == 0) {
+        char *copia = strdup(valor);
+        if (!copia || copia[0] == '\0') {
+            fprintf(stderr, "Erro: valor inválido para out_dir\n");
+            free(copia);
+            return -1;
+        }
+        OUT_DIR = copia; // vive até o fim do processo
+        return 0;
+    }
+    fprintf(stderr, "Erro: regra desconhecida: %s (use decks, penetracao, jogadores, shoes ou out_dir)\n", chave);
+    return -1;
+}
+
+static char *aparar(char *texto) {
+    while (isspace((unsigned char)*texto)) texto++;
+    char *fim = texto + strlen(texto);
+    while (fim > texto && isspace((unsigned char)fim[-1])) *--fim = '\0';
+    return texto;
+}
+
+int constantes_carregar_arquivo(const char *caminho) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        fprintf(stderr, "Erro ao abrir arquivo de configuração %s\n", caminho);
+        return -1;
+    }
+
+    char linha[512];
+    int numero = 0;
+    int resultado = 0;
+    while (fgets(linha, sizeof(linha), arquivo)) {
+        numero++;
+        char *comentario = strchr(linha, '#');
+        if (comentario) *comentario = '\0';
+        char *texto = aparar(linha);
+        if (*texto == '\0') continue;
+
+        char *igual = strchr(texto, '=');
+        if (!igual) {
+            fprintf(stderr, "%s:%d: esperado 'chave = valor'\n", caminho, numero);
+            resultado = -1;
+            break;
+        }
+        *igual = '\0';
+        if (constantes_definir(aparar(texto), aparar(igual + 1)) != 0) {
+            fprintf(stderr, "%s:%d: configuração rejeitada\n", caminho, numero);
+            resultado = -1;
+            break;
+        }
+    }
+    fclose(arquivo);
+    return resultado;
+}
@@ -2,16 +2,21 @@
 #define CONSTANTES_H
 
 #include <stdatomic.h>
+#include <stdint.h>
 #include <pthread.h>
 
-extern const int NUM_JOGADORES;
-extern const int DECKS;
-extern const double PENETRACAO;
+// Regras da mesa: valores padrão em constantes.c, sobrescritos em tempo de
+// execução por arquivo de configuração (-config) ou pela linha de comando
+// antes de criar as threads. Depois disso são somente leitura.
+extern int NUM_JOGADORES;
+extern int DECKS;
+extern double PENETRACAO;
 extern const double UNIDADE;
-extern const int NUM_SHOES;
+extern int NUM_SHOES;
 extern const int NUM_SIMS;
 extern const char* OUT_DIR;
-extern const double WONG_HALVES[13];
+extern const double WONG_HALVES[13];      // Wong Halves em double (ferramentas e testes)
+extern const int8_t WONG_HALVES_X2[13];   // Wong Halves x2, contagem inteira do simulador
 extern const double MIN_COUNT_INS;
 extern const double TEN_perc;
 
@@ -30,8 +35,10 @@ extern const double APOSTAS_BASE[12];
 extern const int CARTAS_RESTANTES_LIMITE;
 extern const int CARTAS_RESTANTES_SHOE_OK;
 
-// Variável global para acumular unidades totais (protegida por mutex)
-extern double unidades_total_global;
-extern pthread_mutex_t unidades_mutex;
+// Define uma regra por nome (decks, penetracao, jogadores, shoes, out_dir).
+// Retorna 0 em sucesso; em erro imprime a causa e retorna -1.
+int constantes_definir(const char *chave, const char *valor);
+// Lê "chave = valor" por linha (# inicia comentário) e aplica cada regra
+int constantes_carregar_arquivo(const char *caminho);
 
 #endif // CONSTANTES_H 
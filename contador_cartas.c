@@ -0,0 +1,38 @@
+#include "contador_cartas.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Tabela de recíprocos da thread, reaproveitada entre shoes
+static __thread double *inv_thread = NULL;
+static __thread size_t inv_total = 0;
+
+static void obter_reciprocos(size_t total_cartas) {
+    if (inv_thread && inv_total == total_cartas) return;
+    double *novo = (double*)realloc(inv_thread, sizeof(double) * (total_cartas + 1));
+    if (!novo) {
+        perror("realloc");
+        exit(EXIT_FAILURE);
+    }
+    // Baralhos restantes com piso de 1 no fim do shoe
+    for (size_t r = 0; r <= total_cartas; ++r) {
+        double decks_restantes = (double)r / 52.0;
+        if (decks_restantes < 1.0) decks_restantes = 1.0;
+        novo[r] = 1.0 / decks_restantes;
+    }
+    inv_thread = novo;
+    inv_total = total_cartas;
+}
+
+void contador_cartas_iniciar(ContadorCartas *cc, int num_decks, size_t total_cartas) {
+    shoe_counter_init(&cc->shoe, num_decks);
+    cc->rc2 = 0;
+    cc->true_count = 0.0;
+    obter_reciprocos(total_cartas);
+    cc->inv_baralhos = inv_thread;
+}
+
+void contador_cartas_liberar_thread(void) {
+    free(inv_thread);
+    inv_thread = NULL;
+    inv_total = 0;
+}
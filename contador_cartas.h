@@ -0,0 +1,66 @@
+#ifndef CONTADOR_CARTAS_H
+#define CONTADOR_CARTAS_H
+
+#include "baralho.h"
+#include "shoe_counter.h"
+#include "constantes.h"
+#include "structures.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Acompanhamento das cartas vistas no shoe, atualizado uma vez por carta:
+// contagem por rank (ShoeCounter, usado pelo EV em tempo real e pelo seguro),
+// running count Wong Halves e true count já calculado.
+//
+// A contagem é inteira: rc2 = running count x 2 (Halves x2 cabe em int16 com
+// folga para 8 baralhos). O true count é rc2 / 2 / max(1, r / 52), com r =
+// cartas restantes no shoe, pelo recíproco de uma tabela por r montada uma vez
+// por thread (sem divisão por carta). Escalar rc2 por 0.5 é exato, então o
+// true count é bit a bit o de running_count em double / baralhos restantes, e
+// o bin de TC (get_bin_index_robust) é o mesmo das tabelas e CSVs existentes.
+//
+// A hole card do dealer sai do shoe antes de ser vista: ela é comprada com
+// baralho_comprar e só entra aqui (contador_cartas_registrar) quando revelada.
+typedef struct {
+    ShoeCounter shoe;
+    int16_t rc2;                    // running count x 2
+    double true_count;
+    const double *inv_baralhos;     // [r] -> 1 / max(1, r / 52)
+} ContadorCartas;
+
+// Zera o contador para um shoe novo de num_decks baralhos (total_cartas no shoe)
+void contador_cartas_iniciar(ContadorCartas *cc, int num_decks, size_t total_cartas);
+// Libera a tabela de recíprocos da thread (chamar antes da thread terminar)
+void contador_cartas_liberar_thread(void);
+
+static inline void contador_cartas_registrar(ContadorCartas *cc, int rank_idx, size_t cartas_restantes) {
+    cc->shoe.counts[rank_idx]--;
+    cc->shoe.total_cards--;
+    cc->rc2 += WONG_HALVES_X2[rank_idx];
+    cc->true_count = (cc->rc2 * 0.5) * cc->inv_baralhos[cartas_restantes];
+}
+
+// Compra uma carta vista por todos e já a contabiliza
+static inline Carta contador_cartas_comprar(ContadorCartas *cc, Shoe *shoe, int *rank_idx_out) {
+    Carta c = baralho_comprar(shoe);
+    int rank_idx = carta_para_rank_idx(c);
+    // Carta substituta (shoe vazio) não existe no shoe: não entra na contagem
+    if (__builtin_expect(shoe->compras_sem_carta != 0, 0)) {
+        if (rank_idx_out) *rank_idx_out = rank_idx;
+        return c;
+    }
+    contador_cartas_registrar(cc, rank_idx, shoe->total - shoe->topo);
+    if (rank_idx_out) *rank_idx_out = rank_idx;
+    return c;
+}
+
+static inline double contador_cartas_running_count(const ContadorCartas *cc) {
+    return cc->rc2 * 0.5;
+}
+
+// Bin de TC (MIN_TC, BIN_WIDTH e MAX_BINS de structures.h) do true count atual
+static inline int contador_cartas_bin_tc(const ContadorCartas *cc) {
+    return get_bin_index_robust(cc->true_count);
+}
+
+#endif // CONTADOR_CARTAS_H
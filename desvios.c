@@ -0,0 +1,243 @@
+#include "desvios.h"
+#include "fsm_mao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdatomic.h>
+
+typedef struct {
+    ClasseEstrategia classe;
+    int valor;
+    int upcard;          // 2..11
+    bool maior_igual;    // true: TC >= limite; false: TC < limite
+    int limite;
+    AcaoEstrategia acao;
+    char texto[64];      // linha original, para o relatório
+} RegraDesvio;
+
+static RegraDesvio regras[DESVIO_MAX_REGRAS];
+static int num_regras = 0;
+static bool habilitados = true;
+static uint64_t hash_arquivo = 0;  // FNV-1a do texto do arquivo de regras
+
+// Célula = (id da regra + 1) << 8 | ação; 0 = sem regra (estratégia básica
+// em uso, que pode ser trocada por -estrategia ou pela variante de -crn)
+static uint16_t (*tabela)[FSM_NUM_ESTADOS][10] = NULL;
+
+static __thread uint64_t acertos_thread[DESVIO_MAX_REGRAS + 1];
+static _Atomic uint64_t acertos_total[DESVIO_MAX_REGRAS + 1];
+
+static char *aparar(char *texto) {
+    while (isspace((unsigned char)*texto)) texto++;
+    char *fim = texto + strlen(texto);
+    while (fim > texto && isspace((unsigned char)fim[-1])) *--fim = '\0';
+    return texto;
+}
+
+static int ler_inteiro(const char *texto, int *valor) {
+    char *fim = NULL;
+    long v = strtol(texto, &fim, 10);
+    if (fim == texto || *fim != '\0') return -1;
+    *valor = (int)v;
+    return 0;
+}
+
+static int ler_carta(const char *texto, int *valor) {
+    if (strcmp(texto, "A") == 0) {
+        *valor = 11;
+        return 0;
+    }
+    if (ler_inteiro(texto, valor) != 0 || *valor < 2 || *valor > 11) return -1;
+    return 0;
+}
+
+static int ler_regra(char *texto, RegraDesvio *r, const char *caminho, int numero) {
+    char tipo[16], valor[16], upcard[16], op[16], limite[16], acao[16], extra[2];
+    int campos = sscanf(texto, "%15s %15s %15s %15s %15s %15s %1s", tipo, valor, upcard, op, limite, acao, extra);
+    if (campos != 6) {
+        fprintf(stderr, "%s:%d: esperado '<hard|soft|par> <valor> <upcard> <>=|<> <tc> <ação>'\n", caminho, numero);
+        return -1;
+    }
+
+    if (strcmp(tipo, "hard") == 0) {
+        r->classe = CLASSE_HARD;
+        if (ler_inteiro(valor, &r->valor) != 0 || r->valor < 3 || r->valor > 21) {
+            fprintf(stderr, "%s:%d: valor hard '%s' inválido (3 a 21)\n", caminho, numero, valor);
+            return -1;
+        }
+    } else if (strcmp(tipo, "soft") == 0) {
+        r->classe = CLASSE_SOFT;
+        if (ler_inteiro(valor, &r->valor) != 0 || r->valor < 13 || r->valor > 21) {
+            fprintf(stderr, "%s:%d: valor soft '%s' inválido (13 a 21)\n", caminho, numero, valor);
+            return -1;
+        }
+    } else if (strcmp(tipo, "par") == 0) {
+        r->classe = CLASSE_PAR;
+        if (ler_carta(valor, &r->valor) != 0) {
+            fprintf(stderr, "%s:%d: carta do par '%s' inválida (2 a 10 ou A)\n", caminho, numero, valor);
+            return -1;
+        }
+    } else {
+        fprintf(stderr, "%s:%d: tipo '%s' inválido (hard, soft ou par)\n", caminho, numero, tipo);
+        return -1;
+    }
+
+    if (ler_carta(upcard, &r->upcard) != 0) {
+        fprintf(stderr, "%s:%d: upcard '%s' inválida (2 a 10 ou A)\n", caminho, numero, upcard);
+        return -1;
+    }
+    if (strcmp(op, ">=") == 0) {
+        r->maior_igual = true;
+    } else if (strcmp(op, "<") == 0) {
+        r->maior_igual = false;
+    } else {
+        fprintf(stderr, "%s:%d: operador '%s' inválido (>= ou <)\n", caminho, numero, op);
+        return -1;
+    }
+    // Limites inteiros dentro das faixas: a comparação com floor(TC) é exata
+    if (ler_inteiro(limite, &r->limite) != 0 || r->limite <= DESVIO_TC_MIN || r->limite > DESVIO_TC_MAX) {
+        fprintf(stderr, "%s:%d: TC '%s' inválido (inteiro de %d a %d)\n", caminho, numero, limite,
+                DESVIO_TC_MIN + 1, DESVIO_TC_MAX);
+        return -1;
+    }
+    if (estrategia_ler_acao(acao, &r->acao) != 0) {
+        fprintf(stderr, "%s:%d: ação '%s' inválida (H, S, D, DH, DS, P, PH ou PS)\n", caminho, numero, acao);
+        return -1;
+    }
+    if (r->classe != CLASSE_PAR &&
+        (r->acao == ACAO_SPLIT || r->acao == ACAO_SPLIT_OR_HIT || r->acao == ACAO_SPLIT_OR_STAND)) {
+        fprintf(stderr, "%s:%d: split só é permitido em linhas de par\n", caminho, numero);
+        return -1;
+    }
+    snprintf(r->texto, sizeof(r->texto), "%s %s vs %s, TC %s %d: %s", tipo, valor, upcard, op, r->limite, acao);
+    return 0;
+}
+
+// Células sem regra ficam em 0 (estratégia básica em uso); aplica as regras em ordem
+static int compilar_tabela(void) {
+    size_t bytes = sizeof(*tabela) * DESVIO_NUM_FAIXAS;
+    free(tabela);
+    tabela = aligned_alloc(64, bytes);
+    if (!tabela) {
+        perror("aligned_alloc");
+        return -1;
+    }
+    memset(tabela, 0, bytes);
+    estrategia_flat_inicializar();
+
+    for (int id = 0; id < num_regras; ++id) {
+        const RegraDesvio *r = &regras[id];
+        uint16_t celula = (uint16_t)(((id + 1) << 8) | r->acao);
+        for (int estado = 0; estado < FSM_NUM_ESTADOS; ++estado) {
+            int valor;
+            if (estrategia_classe_estado((uint16_t)estado, &valor) != r->classe || valor != r->valor) continue;
+            for (int f = 0; f < DESVIO_NUM_FAIXAS; ++f) {
+                int tc = DESVIO_TC_MIN + f;
+                bool aplica = r->maior_igual ? tc >= r->limite : tc < r->limite;
+                if (aplica) tabela[f][estado][r->upcard - 2] = celula;
+            }
+        }
+    }
+    return 0;
+}
+
+int desvios_carregar_arquivo(const char *caminho) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        fprintf(stderr, "Erro ao abrir arquivo de desvios %s\n", caminho);
+        return -1;
+    }
+
+    char linha[512];
+    int numero = 0;
+    int resultado = 0;
+    num_regras = 0;
+    hash_arquivo = 0xcbf29ce484222325ULL;
+    while (fgets(linha, sizeof(linha), arquivo)) {
+        for (const char *p = linha; *p; ++p) {
+            hash_arquivo ^= (uint8_t)*p;
+            hash_arquivo *= 0x100000001b3ULL;
+        }
+        numero++;
+        char *comentario = strchr(linha, '#');
+        if (comentario) *comentario = '\0';
+        char *texto = aparar(linha);
+        if (*texto == '\0') continue;
+
+        if (num_regras >= DESVIO_MAX_REGRAS) {
+            fprintf(stderr, "%s:%d: mais de %d regras de desvio\n", caminho, numero, DESVIO_MAX_REGRAS);
+            resultado = -1;
+            break;
+        }
+        if (ler_regra(texto, &regras[num_regras], caminho, numero) != 0) {
+            resultado = -1;
+            break;
+        }
+        num_regras++;
+    }
+    fclose(arquivo);
+
+    if (resultado == 0) resultado = compilar_tabela();
+    if (resultado != 0) num_regras = 0;
+    return resultado;
+}
+
+void desvios_set_habilitados(bool valor) {
+    habilitados = valor;
+}
+
+bool desvios_ativos(void) {
+    return habilitados && num_regras > 0;
+}
+
+int desvios_num_regras(void) {
+    return num_regras;
+}
+
+uint64_t desvios_hash(void) {
+    return desvios_ativos() ? hash_arquivo : 0;
+}
+
+AcaoEstrategia desvios_acao(uint16_t estado, int dealer_up_rank, double true_count) {
+    unsigned dealer_idx = (unsigned)(dealer_up_rank - 2);
+    if (dealer_idx > 9) return ACAO_HIT;
+
+    // Faixa = floor(TC) saturado em [DESVIO_TC_MIN, DESVIO_TC_MAX]
+    double tc = floor(true_count);
+    if (tc < DESVIO_TC_MIN) tc = DESVIO_TC_MIN;
+    if (tc > DESVIO_TC_MAX) tc = DESVIO_TC_MAX;
+    int faixa = (int)tc - DESVIO_TC_MIN;
+
+    uint16_t celula = tabela[faixa][estado][dealer_idx];
+    if (celula) {
+        acertos_thread[celula >> 8]++;
+        return (AcaoEstrategia)(celula & 0xFF);
+    }
+    return estrategia_basica_estado(estado, dealer_up_rank);
+}
+
+void desvios_acumular_thread(void) {
+    for (int i = 1; i <= num_regras; ++i) {
+        if (acertos_thread[i]) {
+            atomic_fetch_add(&acertos_total[i], acertos_thread[i]);
+            acertos_thread[i] = 0;
+        }
+    }
+}
+
+uint64_t desvios_acertos(int regra) {
+    return atomic_load(&acertos_total[regra + 1]);
+}
+
+void desvios_imprimir_relatorio(void) {
+    if (!desvios_ativos()) return;
+    uint64_t total = 0;
+    for (int id = 0; id < num_regras; ++id) total += desvios_acertos(id);
+
+    printf("Desvios por true count: %d regras, %llu decisões desviadas\n", num_regras, (unsigned long long)total);
+    for (int id = 0; id < num_regras; ++id) {
+        printf("  %-36s %12llu\n", regras[id].texto, (unsigned long long)desvios_acertos(id));
+    }
+}
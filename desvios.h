@@ -0,0 +1,48 @@
+#ifndef DESVIOS_H
+#define DESVIOS_H
+
+#include "tabela_estrategia.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Desvios de estratégia por true count: cada regra troca a ação da
+// estratégia básica de uma mão (hard/soft/par x upcard) a partir de um
+// limite de TC. As regras são compiladas em tabelas por faixa inteira de TC
+// ([DESVIO_TC_MIN, DESVIO_TC_MAX], extremos saturados), então uma decisão é
+// uma leitura em [faixa][estado da mão][upcard], sem recursão nem cálculo
+// de EV.
+//
+// Arquivo de regras (-desvios), uma por linha, '#' inicia comentário:
+//     <hard|soft|par> <valor> <upcard 2..10|A> <>=|<> <tc inteiro> <ação>
+// ação: H, S, D, DH, DS, P, PH ou PS (mesmos códigos da estratégia básica;
+// P, PH e PS só em regras de par).
+// Para par, valor é o da carta (2..10, A = 11). Regras posteriores
+// sobrescrevem as anteriores na mesma célula.
+// Ex.: "hard 16 10 >= 0 S" = parar 16 contra 10 com TC >= 0.
+
+#define DESVIO_TC_MIN (-10)
+#define DESVIO_TC_MAX 10
+#define DESVIO_NUM_FAIXAS (DESVIO_TC_MAX - DESVIO_TC_MIN + 1)
+#define DESVIO_MAX_REGRAS 255
+
+// Carrega e compila as regras (antes das threads); -1 em erro
+int desvios_carregar_arquivo(const char *caminho);
+// -d: mantém a estratégia básica mesmo com regras carregadas
+void desvios_set_habilitados(bool habilitados);
+bool desvios_ativos(void);
+int desvios_num_regras(void);
+// FNV-1a do arquivo de regras carregado; 0 sem desvios ativos (nenhum
+// arquivo ou -d). Identifica os desvios no arquivo de acumuladores.
+uint64_t desvios_hash(void);
+
+// Ação para o estado da mão (fsm_mao.h) contra a upcard com o TC atual;
+// conta o acerto da regra aplicada no contador da thread
+AcaoEstrategia desvios_acao(uint16_t estado, int dealer_up_rank, double true_count);
+
+// Soma os contadores da thread nos totais (chamada ao fim de cada worker)
+void desvios_acumular_thread(void);
+// Acertos acumulados da regra (0..desvios_num_regras()-1)
+uint64_t desvios_acertos(int regra);
+void desvios_imprimir_relatorio(void);
+
+#endif // DESVIOS_H
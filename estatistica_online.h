@@ -0,0 +1,80 @@
+#ifndef ESTATISTICA_ONLINE_H
+#define ESTATISTICA_ONLINE_H
+
+#include <stdint.h>
+
+// Média/variância online (Welford) — combinável entre threads (Chan et al.)
+typedef struct {
+    uint64_t n;
+    double media;
+    double m2;
+} EstatisticaOnline;
+
+static inline void estatistica_adicionar(EstatisticaOnline *e, double x) {
+    e->n++;
+    double delta = x - e->media;
+    e->media += delta / (double)e->n;
+    e->m2 += delta * (x - e->media);
+}
+
+static inline void estatistica_combinar(EstatisticaOnline *destino, const EstatisticaOnline *origem) {
+    if (origem->n == 0) return;
+    if (destino->n == 0) {
+        *destino = *origem;
+        return;
+    }
+    double n_a = (double)destino->n;
+    double n_b = (double)origem->n;
+    double delta = origem->media - destino->media;
+    double n = n_a + n_b;
+    destino->media += delta * n_b / n;
+    destino->m2 += origem->m2 + delta * delta * n_a * n_b / n;
+    destino->n += origem->n;
+}
+
+static inline double estatistica_variancia(const EstatisticaOnline *e) {
+    return (e->n > 1) ? e->m2 / (double)(e->n - 1) : 0.0;
+}
+
+// Soma compensada (Neumaier): erro de arredondamento acumulado em separado,
+// de modo que milhões de parcelas pequenas somam como em precisão estendida
+typedef struct {
+    double soma;
+    double compensacao;
+} SomaCompensada;
+
+// -ffast-math reassociaria (soma - t) + x em (soma + x) - t, que é 0: a
+// barreira força o arredondamento de cada passo na ordem escrita
+#if defined(__SSE2__)
+#define SOMA_BARREIRA(v) __asm__("" : "+x"(v))
+#else
+#define SOMA_BARREIRA(v) __asm__("" : "+m"(v))
+#endif
+
+static inline void soma_compensada_adicionar(SomaCompensada *s, double x) {
+    double t = s->soma + x;
+    SOMA_BARREIRA(t);
+    double erro;
+    if (__builtin_fabs(s->soma) >= __builtin_fabs(x)) {
+        erro = s->soma - t;
+        SOMA_BARREIRA(erro);
+        erro += x;
+    } else {
+        erro = x - t;
+        SOMA_BARREIRA(erro);
+        erro += s->soma;
+    }
+    s->compensacao += erro;
+    s->soma = t;
+}
+
+static inline void soma_compensada_combinar(SomaCompensada *destino, const SomaCompensada *origem) {
+    soma_compensada_adicionar(destino, origem->soma);
+    soma_compensada_adicionar(destino, origem->compensacao);
+}
+
+static inline double soma_compensada_valor(const SomaCompensada *s) {
+    return s->soma + s->compensacao;
+}
+
+#endif // ESTATISTICA_ONLINE_H
@@ -0,0 +1,303 @@
+#define _DEFAULT_SOURCE
+#include "estrategia_arquivo.h"
+#include "fsm_mao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+typedef struct {
+    char magic[8];
+    uint32_t versao;
+    uint32_t num_estados;
+    uint64_t hash_texto;        // FNV-1a do arquivo texto (chave do cache)
+    uint64_t assinatura_fsm;    // FNV-1a das tabelas do autômato: ids de estado válidos
+    uint8_t reservado[32];      // cabeçalho com 64 bytes
+} CabecalhoEstrategiaCache;
+
+_Static_assert(sizeof(CabecalhoEstrategiaCache) == 64, "cabeçalho do cache de estratégia deve ter 64 bytes");
+
+struct EstrategiaCompilada {
+    uint8_t tabela[FSM_NUM_ESTADOS][10] __attribute__((aligned(64)));
+    uint64_t hash;
+    bool do_cache;
+    char nome[128];
+};
+
+static EstrategiaCompilada *carregadas[ESTRATEGIA_MAX_CARREGADAS];
+static int num_carregadas = 0;
+
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIMO  0x100000001b3ULL
+
+static uint64_t fnv1a(uint64_t hash, const void *dados, size_t n) {
+    const uint8_t *p = (const uint8_t*)dados;
+    for (size_t i = 0; i < n; ++i) {
+        hash ^= p[i];
+        hash *= FNV_PRIMO;
+    }
+    return hash;
+}
+
+static uint64_t assinatura_fsm(void) {
+    uint64_t hash = fnv1a(FNV_OFFSET, FSM_TRANSICAO, sizeof(FSM_TRANSICAO));
+    return fnv1a(hash, FSM_ATRIBUTOS, sizeof(FSM_ATRIBUTOS));
+}
+
+static char *ler_arquivo(const char *caminho, size_t *tamanho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        fprintf(stderr, "Erro ao abrir arquivo de estratégia %s: %s\n", caminho, strerror(errno));
+        return NULL;
+    }
+    size_t capacidade = 4096, n = 0;
+    char *texto = (char*)malloc(capacidade + 1);
+    while (texto) {
+        n += fread(texto + n, 1, capacidade - n, f);
+        if (n < capacidade) break;
+        capacidade *= 2;
+        char *maior = (char*)realloc(texto, capacidade + 1);
+        if (!maior) {
+            free(texto);
+            texto = NULL;
+            break;
+        }
+        texto = maior;
+    }
+    fclose(f);
+    if (!texto) {
+        perror("malloc");
+        return NULL;
+    }
+    texto[n] = '\0';
+    *tamanho = n;
+    return texto;
+}
+
+static int ler_linha_estrategia(char *linha, TabelasEstrategia *t, bool vistas[38],
+                                const char *caminho, int numero) {
+    char *salvo = NULL;
+    char *tipo = strtok_r(linha, " \t\r", &salvo);
+    char *valor_txt = strtok_r(NULL, " \t\r", &salvo);
+    if (!tipo || !valor_txt) {
+        fprintf(stderr, "%s:%d: esperado '<hard|soft|par> <valor> <10 ações>'\n", caminho, numero);
+        return -1;
+    }
+
+    char *fim = NULL;
+    long valor = strcmp(valor_txt, "A") == 0 ? 11 : strtol(valor_txt, &fim, 10);
+    bool valor_ok = strcmp(valor_txt, "A") == 0 || (fim && *fim == '\0' && fim != valor_txt);
+    uint8_t *linha_tabela;
+    int indice_vista;
+    bool aceita_split;
+    if (strcmp(tipo, "hard") == 0 && valor_ok && valor >= 3 && valor <= 21) {
+        linha_tabela = t->hard[valor - 3];
+        indice_vista = (int)valor - 3;
+        aceita_split = false;
+    } else if (strcmp(tipo, "soft") == 0 && valor_ok && valor >= 13 && valor <= 21) {
+        linha_tabela = t->soft[valor - 13];
+        indice_vista = 19 + (int)valor - 13;
+        aceita_split = false;
+    } else if (strcmp(tipo, "par") == 0 && valor_ok && valor >= 2 && valor <= 11) {
+        linha_tabela = t->par[valor - 2];
+        indice_vista = 28 + (int)valor - 2;
+        aceita_split = true;
+    } else {
+        fprintf(stderr, "%s:%d: linha '%s %s' inválida (hard 3..21, soft 13..21, par 2..10 ou A)\n",
+                caminho, numero, tipo, valor_txt);
+        return -1;
+    }
+    if (vistas[indice_vista]) {
+        fprintf(stderr, "%s:%d: linha '%s %s' repetida\n", caminho, numero, tipo, valor_txt);
+        return -1;
+    }
+    vistas[indice_vista] = true;
+
+    for (int d = 0; d < 10; ++d) {
+        char *codigo = strtok_r(NULL, " \t\r", &salvo);
+        AcaoEstrategia acao;
+        if (!codigo) {
+            fprintf(stderr, "%s:%d: esperadas 10 ações (upcards 2..10, A), encontradas %d\n", caminho, numero, d);
+            return -1;
+        }
+        if (estrategia_ler_acao(codigo, &acao) != 0) {
+            fprintf(stderr, "%s:%d: ação '%s' inválida (H, S, D, DH, DS, P, PH ou PS)\n", caminho, numero, codigo);
+            return -1;
+        }
+        if (!aceita_split && (acao == ACAO_SPLIT || acao == ACAO_SPLIT_OR_HIT || acao == ACAO_SPLIT_OR_STAND)) {
+            fprintf(stderr, "%s:%d: split só é permitido em linhas de par\n", caminho, numero);
+            return -1;
+        }
+        linha_tabela[d] = (uint8_t)acao;
+    }
+    if (strtok_r(NULL, " \t\r", &salvo)) {
+        fprintf(stderr, "%s:%d: mais de 10 ações na linha\n", caminho, numero);
+        return -1;
+    }
+    return 0;
+}
+
+static int ler_tabelas(char *texto, TabelasEstrategia *t, const char *caminho) {
+    bool vistas[38] = {false};
+    int numero = 0;
+    char *salvo = NULL;
+    // strtok_r pularia linhas vazias e desalinharia a numeração: separar à mão
+    for (char *linha = texto; linha; linha = salvo) {
+        salvo = strchr(linha, '\n');
+        if (salvo) *salvo++ = '\0';
+        numero++;
+        char *comentario = strchr(linha, '#');
+        if (comentario) *comentario = '\0';
+        while (isspace((unsigned char)*linha)) linha++;
+        if (*linha == '\0') continue;
+        if (ler_linha_estrategia(linha, t, vistas, caminho, numero) != 0) return -1;
+    }
+
+    static const char *faltando[3] = {"hard", "soft", "par"};
+    for (int i = 0; i < 38; ++i) {
+        if (!vistas[i]) {
+            int grupo = i < 19 ? 0 : (i < 28 ? 1 : 2);
+            int valor = grupo == 0 ? i + 3 : (grupo == 1 ? i - 19 + 13 : i - 28 + 2);
+            fprintf(stderr, "%s: falta a linha '%s %d'\n", caminho, faltando[grupo], valor);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void caminho_cache(const char *caminho, uint64_t hash, char *saida, size_t tamanho, char *dir, size_t tamanho_dir) {
+    const char *barra = strrchr(caminho, '/');
+    int prefixo = barra ? (int)(barra - caminho) : 1;
+    snprintf(dir, tamanho_dir, "%.*s/.cache", prefixo, barra ? caminho : ".");
+    snprintf(saida, tamanho, "%s/%016llx.bin", dir, (unsigned long long)hash);
+}
+
+static bool ler_cache(const char *arquivo_cache, uint64_t hash, EstrategiaCompilada *e) {
+    FILE *f = fopen(arquivo_cache, "rb");
+    if (!f) return false;
+    CabecalhoEstrategiaCache cab;
+    bool ok = fread(&cab, sizeof(cab), 1, f) == 1 &&
+              memcmp(cab.magic, ESTRATEGIA_CACHE_MAGIC, sizeof(cab.magic)) == 0 &&
+              cab.versao == ESTRATEGIA_CACHE_VERSAO &&
+              cab.num_estados == FSM_NUM_ESTADOS &&
+              cab.hash_texto == hash &&
+              cab.assinatura_fsm == assinatura_fsm() &&
+              fread(e->tabela, sizeof(e->tabela), 1, f) == 1 &&
+              fgetc(f) == EOF;
+    fclose(f);
+    if (!ok) return false;
+
+    // Blob íntegro mas de origem desconhecida: só ações válidas
+    for (int estado = 0; estado < FSM_NUM_ESTADOS; ++estado) {
+        for (int d = 0; d < 10; ++d) {
+            if (e->tabela[estado][d] > ACAO_SPLIT_OR_STAND) return false;
+        }
+    }
+    return true;
+}
+
+// Falha ao gravar o cache não impede o uso da estratégia: só avisa
+static void gravar_cache(const char *dir, const char *arquivo_cache, const EstrategiaCompilada *e) {
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Aviso: não foi possível criar %s: %s\n", dir, strerror(errno));
+        return;
+    }
+    CabecalhoEstrategiaCache cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magic, ESTRATEGIA_CACHE_MAGIC, sizeof(cab.magic));
+    cab.versao = ESTRATEGIA_CACHE_VERSAO;
+    cab.num_estados = FSM_NUM_ESTADOS;
+    cab.hash_texto = e->hash;
+    cab.assinatura_fsm = assinatura_fsm();
+
+    // Grava em arquivo temporário e renomeia: leitores nunca veem blob parcial
+    char temporario[1100];
+    snprintf(temporario, sizeof(temporario), "%s.%ld.tmp", arquivo_cache, (long)getpid());
+    FILE *f = fopen(temporario, "wb");
+    if (!f) {
+        fprintf(stderr, "Aviso: não foi possível gravar o cache %s: %s\n", temporario, strerror(errno));
+        return;
+    }
+    bool ok = fwrite(&cab, sizeof(cab), 1, f) == 1 && fwrite(e->tabela, sizeof(e->tabela), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(temporario, arquivo_cache) != 0) {
+        fprintf(stderr, "Aviso: não foi possível gravar o cache %s\n", arquivo_cache);
+        remove(temporario);
+    }
+}
+
+const EstrategiaCompilada* estrategia_carregar(const char *caminho) {
+    size_t tamanho = 0;
+    char *texto = ler_arquivo(caminho, &tamanho);
+    if (!texto) return NULL;
+    uint64_t hash = fnv1a(FNV_OFFSET, texto, tamanho);
+
+    for (int i = 0; i < num_carregadas; ++i) {
+        if (carregadas[i]->hash == hash) {
+            free(texto);
+            return carregadas[i];
+        }
+    }
+    if (num_carregadas >= ESTRATEGIA_MAX_CARREGADAS) {
+        fprintf(stderr, "Erro: máximo de %d estratégias carregadas\n", ESTRATEGIA_MAX_CARREGADAS);
+        free(texto);
+        return NULL;
+    }
+
+    EstrategiaCompilada *e = (EstrategiaCompilada*)aligned_alloc(64, sizeof(EstrategiaCompilada));
+    if (!e) {
+        perror("aligned_alloc");
+        free(texto);
+        return NULL;
+    }
+    memset(e, 0, sizeof(*e));
+    e->hash = hash;
+    const char *barra = strrchr(caminho, '/');
+    snprintf(e->nome, sizeof(e->nome), "%s", barra ? barra + 1 : caminho);
+
+    char dir[1024], arquivo_cache[1100];
+    caminho_cache(caminho, hash, arquivo_cache, sizeof(arquivo_cache), dir, sizeof(dir));
+    if (ler_cache(arquivo_cache, hash, e)) {
+        e->do_cache = true;
+    } else {
+        TabelasEstrategia tabelas;
+        if (ler_tabelas(texto, &tabelas, caminho) != 0) {
+            free(texto);
+            free(e);
+            return NULL;
+        }
+        estrategia_compilar(&tabelas, e->tabela);
+        gravar_cache(dir, arquivo_cache, e);
+    }
+    free(texto);
+
+    carregadas[num_carregadas++] = e;
+    return e;
+}
+
+const uint8_t (*estrategia_tabela(const EstrategiaCompilada *e))[10] {
+    return (const uint8_t (*)[10])e->tabela;
+}
+
+const char* estrategia_nome(const EstrategiaCompilada *e) {
+    return e->nome;
+}
+
+uint64_t estrategia_hash(const EstrategiaCompilada *e) {
+    return e->hash;
+}
+
+bool estrategia_do_cache(const EstrategiaCompilada *e) {
+    return e->do_cache;
+}
+
+void estrategia_descarregar_todas(void) {
+    for (int i = 0; i < num_carregadas; ++i) {
+        free(carregadas[i]);
+        carregadas[i] = NULL;
+    }
+    num_carregadas = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef ESTRATEGIA_ARQUIVO_H
+#define ESTRATEGIA_ARQUIVO_H
+
+#include "tabela_estrategia.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Estratégias básicas carregadas de arquivo texto (Estrategias/*.txt), uma
+// linha por total/par, '#' inicia comentário:
+//     hard <3..21>      <10 ações para upcards 2, 3, ..., 10, A>
+//     soft <13..21>     <10 ações>
+//     par  <2..10|A>    <10 ações>
+// Ações: H, S, D, DH, DS, P, PH, PS. Todas as 38 linhas são obrigatórias e
+// hard/soft não aceitam split.
+//
+// O arquivo é validado e compilado uma vez na tabela plana estado x upcard;
+// o resultado é gravado em <dir do arquivo>/.cache/<hash>.bin, com o hash
+// FNV-1a do conteúdo como chave. Execuções seguintes (ou o mesmo arquivo
+// citado por várias variantes) leem a tabela pronta, sem parsing.
+
+#define ESTRATEGIA_CACHE_MAGIC "BJEST001"
+#define ESTRATEGIA_CACHE_VERSAO 1
+#define ESTRATEGIA_MAX_CARREGADAS 64
+
+typedef struct EstrategiaCompilada EstrategiaCompilada;
+
+// Carrega (antes das threads). Retorna NULL em erro, após imprimir a causa.
+// O mesmo conteúdo carregado duas vezes devolve a mesma estratégia.
+const EstrategiaCompilada* estrategia_carregar(const char *caminho);
+
+const uint8_t (*estrategia_tabela(const EstrategiaCompilada *e))[10];
+const char* estrategia_nome(const EstrategiaCompilada *e);
+uint64_t estrategia_hash(const EstrategiaCompilada *e);
+bool estrategia_do_cache(const EstrategiaCompilada *e);
+
+// Libera todas as estratégias carregadas (fim do processo)
+void estrategia_descarregar_todas(void);
+
+#endif // ESTRATEGIA_ARQUIVO_H
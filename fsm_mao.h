@@ -0,0 +1,54 @@
+#ifndef FSM_MAO_H
+#define FSM_MAO_H
+
+#include <stdint.h>
+#include "mao_bits.h"
+
+// Autômato de mãos: para o jogo, uma mão é determinada por total (ás = 1),
+// presença de ás, nº de cartas (0, 1, 2, 3+), rank da primeira carta (só
+// com 1 carta) e rank do par (só com 2 cartas). Cada estado alcançável tem
+// um id; adicionar uma carta é uma leitura em FSM_TRANSICAO[estado][rank].
+// As tabelas são geradas por gerar_fsm_mao.c durante o build
+// (fsm_mao_tabela.h) e conferidas por Tests/validacao_fsm_mao.c.
+
+// Bits de FsmAtributos.flags
+#define FSM_BUST         0x01  // valor > 21 (estado absorvente)
+#define FSM_DEALER_PARA  0x02  // valor >= 17: dealer para (inclui bust)
+#define FSM_SOFT         0x04  // um ás contando 11
+#define FSM_BLACKJACK    0x08  // duas cartas somando 21
+
+typedef struct {
+    uint8_t valor;       // igual a calcular_valor_mao
+    uint8_t tipo;        // TipoMao, igual a tipo_mao
+    uint8_t flags;
+    uint8_t num_cartas;  // 0, 1, 2 ou 3 (= 3 ou mais)
+    int8_t par_rank;     // índice de rank (0..12) do par de 2 cartas, -1 se não for par
+} FsmAtributos;
+
+#define FSM_ESTADO_VAZIO 0
+
+#ifndef FSM_MAO_GERADOR
+#include "fsm_mao_tabela.h"
+
+static inline uint16_t fsm_proximo(uint16_t estado, int rank_idx) {
+    return FSM_TRANSICAO[estado][rank_idx];
+}
+
+static inline const FsmAtributos *fsm_atributos(uint16_t estado) {
+    return &FSM_ATRIBUTOS[estado];
+}
+
+// Estado da mão a partir dos bits (4 bits por rank), em ordem de rank
+static inline uint16_t fsm_estado_de_bits(uint64_t bits) {
+    uint16_t estado = FSM_ESTADO_VAZIO;
+    for (int idx = 0; idx < 13; ++idx) {
+        int count = mao_bits_contagem(bits, idx);
+        for (int k = 0; k < count; ++k) {
+            estado = FSM_TRANSICAO[estado][idx];
+        }
+    }
+    return estado;
+}
+#endif // FSM_MAO_GERADOR
+
+#endif // FSM_MAO_H
@@ -0,0 +1,134 @@
+// Gerador das tabelas do autômato de mãos (fsm_mao_tabela.h).
+// Executado pelo Makefile: ./gerar_fsm_mao > fsm_mao_tabela.h
+//
+// Enumera por busca em largura todos os estados alcançáveis a partir da mão
+// vazia e emite a tabela de transição (estado x rank -> estado) e os
+// atributos de cada estado. A conferência contra calcular_valor_mao/tipo_mao
+// fica em Tests/validacao_fsm_mao.c.
+
+#define FSM_MAO_GERADOR
+#include "fsm_mao.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Mesma ordem de TipoMao (jogo.h)
+enum { TIPO_HARD = 0, TIPO_SOFT, TIPO_PAR, TIPO_BLACKJACK };
+
+#define MAX_ESTADOS 1024
+
+// Valor de cada rank (2..9, T, J, Q, K, A) com ás valendo 1
+static const int VALOR_DURO[13] = {2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 1};
+
+typedef struct {
+    int total;       // soma com ases valendo 1
+    bool tem_as;
+    int num_cartas;  // 0, 1, 2, 3 (3 = 3 ou mais)
+    int rank_info;   // 1 carta: rank da carta; 2 cartas: rank do par; senão -1
+} Estado;
+
+static Estado estados[MAX_ESTADOS];
+static int num_estados = 0;
+static int transicao[MAX_ESTADOS][13];
+
+static bool estado_bust(const Estado *e) {
+    return e->total > 21;
+}
+
+static int buscar_ou_criar(Estado e) {
+    // Bust é absorvente e só o total importa para o valor
+    if (estado_bust(&e)) {
+        e.tem_as = false;
+        e.num_cartas = 3;
+        e.rank_info = -1;
+    }
+    for (int i = 0; i < num_estados; ++i) {
+        const Estado *o = &estados[i];
+        if (o->total == e.total && o->tem_as == e.tem_as &&
+            o->num_cartas == e.num_cartas && o->rank_info == e.rank_info) {
+            return i;
+        }
+    }
+    if (num_estados >= MAX_ESTADOS) {
+        fprintf(stderr, "gerar_fsm_mao: mais de %d estados\n", MAX_ESTADOS);
+        exit(EXIT_FAILURE);
+    }
+    estados[num_estados] = e;
+    return num_estados++;
+}
+
+static Estado adicionar(const Estado *e, int rank) {
+    Estado n = *e;
+    if (estado_bust(e)) return n;
+    n.total += VALOR_DURO[rank];
+    n.tem_as = e->tem_as || rank == 12;
+    n.num_cartas = e->num_cartas < 3 ? e->num_cartas + 1 : 3;
+    if (n.num_cartas == 1) {
+        n.rank_info = rank;
+    } else if (n.num_cartas == 2 && e->rank_info == rank) {
+        n.rank_info = rank;
+    } else {
+        n.rank_info = -1;
+    }
+    return n;
+}
+
+static FsmAtributos atributos(const Estado *e) {
+    FsmAtributos a = {0};
+    bool soft = e->tem_as && e->total + 10 <= 21;
+    int valor = e->total + (soft ? 10 : 0);
+    bool par = e->num_cartas == 2 && e->rank_info >= 0;
+
+    a.valor = (uint8_t)valor;
+    a.num_cartas = (uint8_t)e->num_cartas;
+    a.par_rank = (int8_t)(par ? e->rank_info : -1);
+    if (e->num_cartas == 2 && valor == 21) {
+        a.tipo = TIPO_BLACKJACK;
+        a.flags |= FSM_BLACKJACK;
+    } else if (par) {
+        a.tipo = TIPO_PAR;
+    } else {
+        a.tipo = soft ? TIPO_SOFT : TIPO_HARD;
+    }
+    if (soft) a.flags |= FSM_SOFT;
+    if (valor > 21) a.flags |= FSM_BUST;
+    if (valor >= 17) a.flags |= FSM_DEALER_PARA;
+    return a;
+}
+
+int main(void) {
+    Estado vazio = {0, false, 0, -1};
+    buscar_ou_criar(vazio); // id 0 = FSM_ESTADO_VAZIO
+
+    for (int i = 0; i < num_estados; ++i) {
+        for (int rank = 0; rank < 13; ++rank) {
+            Estado prox = adicionar(&estados[i], rank);
+            transicao[i][rank] = buscar_ou_criar(prox);
+        }
+    }
+
+    printf("// Gerado por gerar_fsm_mao.c - não editar\n");
+    printf("#ifndef FSM_MAO_TABELA_H\n#define FSM_MAO_TABELA_H\n\n");
+    printf("#define FSM_NUM_ESTADOS %d\n\n", num_estados);
+
+    printf("static const uint16_t FSM_TRANSICAO[FSM_NUM_ESTADOS][13] __attribute__((aligned(64))) = {\n");
+    for (int i = 0; i < num_estados; ++i) {
+        printf("    {");
+        for (int rank = 0; rank < 13; ++rank) {
+            printf("%s%d", rank ? "," : "", transicao[i][rank]);
+        }
+        printf("},\n");
+    }
+    printf("};\n\n");
+
+    printf("// {valor, tipo, flags, num_cartas, par_rank}\n");
+    printf("static const FsmAtributos FSM_ATRIBUTOS[FSM_NUM_ESTADOS] __attribute__((aligned(64))) = {\n");
+    for (int i = 0; i < num_estados; ++i) {
+        FsmAtributos a = atributos(&estados[i]);
+        printf("    {%d,%d,0x%02x,%d,%d}, // total=%d%s n=%d r=%d\n",
+               a.valor, a.tipo, a.flags, a.num_cartas, a.par_rank,
+               estados[i].total, estados[i].tem_as ? " ás" : "", estados[i].num_cartas, estados[i].rank_info);
+    }
+    printf("};\n\n#endif // FSM_MAO_TABELA_H\n");
+    return 0;
+}
@@ -5,98 +5,35 @@
 #include "baralho.h"
 #include "constantes.h"
 #include "saidas.h"
-#include "shoe_counter.h"        // Para EV em tempo real
+#include "fsm_mao.h"               // Autômato de mãos (tabela gerada)
+#include "mao_bits.h"              // Kernels SWAR da mão compactada
+#include "desvios.h"               // Desvios por true count (-desvios)
+#include "contador_cartas.h"       // Running/true count e ShoeCounter por carta
 #include "realtime_strategy_integration.h"  // Para EV em tempo real
 #include <stdio.h>
 #include <string.h>
 
 int calcular_valor_mao(uint64_t mao) {
-    int valor = 0;
-    int ases = 0;
-
-    for (int idx = 0; idx < 13; ++idx) {
-        uint64_t count = (mao >> (idx * 3)) & 0x7ULL;
-        if (count == 0) continue;
-
-        if (idx <= 7) { // 2 a 9
-            valor += (idx + 2) * count;
-        } else if (idx <= 11) { // 10, J, Q, K
-            valor += 10 * count;
-        } else { // Ás
-            ases += (int)count;
-        }
-    }
-
-    valor += ases * 11;
-    while (valor > 21 && ases > 0) {
-        valor -= 10;
-        --ases;
-    }
-
-    return valor;
+    return mao_bits_valor(mao);
 }
 
 TipoMao tipo_mao(uint64_t mao) {
-    int total_cartas = 0;
-    int ases = 0;
-    bool par = false;
-
-    int valor_total = calcular_valor_mao(mao); // usar valor calculado
-
-    // contar cartas e verificar par
-    for (int idx = 0; idx < 13; ++idx) {
-        uint64_t count = (mao >> (idx * 3)) & 0x7ULL;
-        if (count == 0) continue;
-        total_cartas += (int)count;
-        if (count == 2 && total_cartas == 2) {
-            par = true; // exatamente um par
-        }
-        if (idx == 12) {
-            ases = (int)count;
-        }
-    }
-
-    if (total_cartas == 2 && valor_total == 21) {
-        return MAO_BLACKJACK;
-    }
-
-    if (par && total_cartas == 2) {
-        return MAO_PAR;
+    if (mao_bits_num_cartas(mao) == 2) {
+        if (mao_bits_valor(mao) == 21) return MAO_BLACKJACK;
+        if (mao_bits_par_rank_idx(mao) >= 0) return MAO_PAR;
     }
-
-    // Determinar se é soft
-    int valor = 0;
-    int ases_restantes = ases;
-    for (int idx = 0; idx < 12; ++idx) {
-        uint64_t count = (mao >> (idx * 3)) & 0x7ULL;
-        if (count == 0) continue;
-        if (idx <= 7) {
-            valor += (idx + 2) * count;
-        } else {
-            valor += 10 * count; // 10 J Q K
-        }
-    }
-    valor += ases_restantes * 11;
-    while (valor > 21 && ases_restantes > 0) {
-        valor -= 10;
-        --ases_restantes;
-    }
-
-    if (ases_restantes > 0) {
-        return MAO_SOFT;
-    }
-    return MAO_HARD;
+    return mao_bits_soft(mao) ? MAO_SOFT : MAO_HARD;
 }
 
 
 // Função auxiliar - pode ser útil para debugging
 //static int rank_from_carta_bits(uint64_t card_bits) {
 //#if defined(__GNUC__)
-//    int idx = __builtin_ctzll(card_bits) / 3;
+//    int idx = __builtin_ctzll(card_bits) / MAO_BITS_POR_RANK;
 //#else
 //    int idx = 0;
-//    while ((card_bits & 0x7ULL) == 0) {
-//        card_bits >>= 3;
+//    while ((card_bits & MAO_CAMPO) == 0) {
+//        card_bits >>= MAO_BITS_POR_RANK;
 //        ++idx;
 //    }
 //#endif
@@ -106,27 +43,40 @@ TipoMao tipo_mao(uint64_t mao) {
 //    return 11;                         // Ace
 //}
 
+// valor/tipo/blackjack a partir do estado do autômato (mesmo resultado de
+// calcular_valor_mao e tipo_mao sobre os bits)
+static inline void mao_atualizar_derivados(Mao *mao) {
+    const FsmAtributos *attr = fsm_atributos(mao->estado);
+    mao->valor = attr->valor;
+    mao->tipo = attr->tipo;
+    mao->blackjack = (mao->tipo == MAO_BLACKJACK && !mao->from_split);
+}
+
+static inline void mao_adicionar_rank(Mao *mao, int rank_idx) {
+    mao->estado = fsm_proximo(mao->estado, rank_idx);
+    mao_atualizar_derivados(mao);
+}
+
+// Reconstrói o estado a partir dos bits (início da mão e split)
+static void mao_estado_de_bits(Mao *mao, uint64_t bits) {
+    mao->estado = fsm_estado_de_bits(bits);
+    mao_atualizar_derivados(mao);
+}
+
 void avaliar_mao(uint64_t bits, Mao *out) {
     out->bits = bits;
     out->initial_bits = bits;
-    out->valor = calcular_valor_mao(bits);
-    out->tipo = tipo_mao(bits);
     out->finalizada = false;
     out->from_split = false;  // Inicializar antes de usar
     out->isdouble = false;
     out->contabilizada = false;
-    out->blackjack = (out->tipo == MAO_BLACKJACK && !out->from_split);
+    mao_estado_de_bits(out, bits);
     out->aposta = 0.0;
     out->pnl = 0.0;
-    out->hist_len = 0;
-    out->historico[0] = '\0';
     out->resultado = '?';
-    // Inicializar campos de split
-    out->split_pair_index = -1;
-    out->split_upcard_index = -1;
-    out->split_cards_used = 0;
     out->split_rank_idx = -1;
-    out->original_split_bits = 0;
+    out->num_acoes = 0;
+    out->fria = NULL;
 }
 
 // Nova função que integra EV em tempo real DE FORMA OTIMIZADA
@@ -139,25 +89,22 @@ AcaoEstrategia determinar_acao_completa(const Mao *mao, uint64_t mao_bits, int d
     // VERIFICAÇÃO GLOBAL: Se o sistema de EV em tempo real está desabilitado, usar apenas estratégia básica
     extern bool realtime_ev_enabled;  // Declaração extern para acessar a variável global
     if (!realtime_ev_enabled) {
-        return estrategia_basica_super_rapida(mao_bits, dealer_up_rank);
+        if (desvios_ativos()) return desvios_acao(mao->estado, dealer_up_rank, true_count);
+        return estrategia_basica_estado(mao->estado, dealer_up_rank);
     }
     
     // SEMPRE usar EV em tempo real quando habilitado
     return determinar_acao_realtime(mao, mao_bits, dealer_up_rank, true_count, shoe_counter, is_initial_hand);
 }
 
-AcaoEstrategia determinar_acao(const Mao *mao, uint64_t mao_bits, int dealer_up_rank) {
-    // SISTEMA DE EV EM TEMPO REAL ATIVADO
-    // Substituindo estratégia básica por cálculos matemáticos precisos
-    
+// Estratégia básica (tabela plana por estado) com os desvios por true count
+// quando houver regras carregadas (-desvios). O EV em tempo real precisa do
+// shoe counter e fica em determinar_acao_completa.
+AcaoEstrategia determinar_acao(const Mao *mao, uint64_t mao_bits, int dealer_up_rank, double true_count) {
+    (void)mao_bits; // a decisão usa só o estado da mão
     if (mao->blackjack) return ACAO_STAND;
-
-    // Para usar EV em tempo real, precisamos de shoe counter e true count
-    // Como estes não estão disponíveis nesta função, vamos usar fallback por enquanto
-    // TODO: Refatorar para incluir estes parâmetros na função
-    
-    // Por enquanto, usar estratégia básica SUPER-OTIMIZADA como fallback
-    return estrategia_basica_super_rapida(mao_bits, dealer_up_rank);
+    if (desvios_ativos()) return desvios_acao(mao->estado, dealer_up_rank, true_count);
+    return estrategia_basica_estado(mao->estado, dealer_up_rank);
 }
 
 const char* acao_to_str(AcaoEstrategia a) {
@@ -175,66 +122,44 @@ const char* acao_to_str(AcaoEstrategia a) {
 }
 
 
-static Carta comprar_carta_e_adicionar(Mao *mao, Shoe *shoe, double *running_count, double *true_count) {
-    Carta c = baralho_comprar(shoe);
+static Carta comprar_carta_e_adicionar(Mao *mao, Shoe *shoe, ContadorCartas *contador) {
+    int rank_idx;
+    Carta c = contador_cartas_comprar(contador, shoe, &rank_idx);
     mao->bits += c;
-	if (running_count) {
-        *running_count += WONG_HALVES[carta_para_rank_idx(c)];
-        if (true_count) {
-            size_t cartas_restantes = shoe->total - shoe->topo;
-            double decks_restantes = (double)cartas_restantes / 52.0;
-            if (decks_restantes < 1.0) decks_restantes = 1.0;
-            *true_count = *running_count / decks_restantes;
-        }
-    }
 
-    // atualizar valor / tipo / blackjack
-    mao->valor = calcular_valor_mao(mao->bits);
-    mao->tipo  = tipo_mao(mao->bits);
-    mao->blackjack = (mao->tipo == MAO_BLACKJACK && !mao->from_split);
+    // atualizar valor / tipo / blackjack em O(1)
+    mao_adicionar_rank(mao, rank_idx);
     return c;
 }
 
 static void registrar_acao(Mao *mao, char code) {
-    int n = mao->hist_len;
-    if (n < (int)sizeof(mao->historico)-1) {
-        mao->historico[n] = code;
-        mao->historico[n+1] = '\0';
-        mao->hist_len++;
+    if (mao->num_acoes < UINT8_MAX) mao->num_acoes++;
+    MaoFria *fria = mao->fria;
+    if (!fria) return;
+    int n = fria->hist_len;
+    if (n < (int)sizeof(fria->historico)-1) {
+        fria->historico[n] = code;
+        fria->historico[n+1] = '\0';
+        fria->hist_len++;
     }
 }
 
-// Helper to duplicate a mao when splitting
+// Helper to duplicate a mao when splitting; preserva o ponteiro fria
 static void inicializar_mao(Mao *mao, uint64_t bits, bool from_split) {
-    mao->bits = bits;
-    mao->initial_bits = bits;
-    mao->from_split = from_split;
-    mao->hist_len = 0;
+    MaoFria *fria = mao->fria;
     avaliar_mao(bits, mao);
+    mao->fria = fria;
+    if (fria) mao_fria_inicializar(fria);
     
     // Corrigir from_split após avaliar_mao (que define como false)
     mao->from_split = from_split;
     // Reavaliar blackjack considerando from_split
     mao->blackjack = (mao->tipo == MAO_BLACKJACK && !from_split);
-    
-    mao->finalizada = false;
-    mao->isdouble = false;
-    mao->contabilizada = false;
-    mao->aposta = 0.0;
-    mao->pnl = 0.0;
-    mao->resultado = '?';
-    
-    // Inicializar campos de split
-    mao->split_pair_index = -1;
-    mao->split_upcard_index = -1;
-    mao->split_cards_used = 0;
-    mao->split_rank_idx = -1;
-    mao->original_split_bits = 0;
 }
 
 
 Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out, 
-               double *running_count, double *true_count, ShoeCounter *shoe_counter, bool ev_realtime_enabled) {
+               ContadorCartas *contador, bool ev_realtime_enabled) {
     if (mao->blackjack) {
         mao->finalizada = true;
         return NULL;
@@ -247,18 +172,16 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
         return NULL;
     }
 
-    // Sistema de EV em tempo real será usado quando shoe_counter estiver disponível
-
     while (!mao->finalizada) {
         // Usar sistema de EV em tempo real se ativado e disponível
         AcaoEstrategia ac;
-        if (ev_realtime_enabled && shoe_counter && shoe_counter->initialized) {
+        if (ev_realtime_enabled) {
             ac = determinar_acao_completa(mao, mao->bits, dealer_up_rank, 
-                                        *true_count, shoe_counter, 
-                                        mao->hist_len == 0); // is_initial_hand
+                                        contador->true_count, &contador->shoe, 
+                                        mao->num_acoes == 0); // is_initial_hand
         } else {
             // Usar estratégia básica (padrão ou fallback)
-            ac = determinar_acao(mao, mao->bits, dealer_up_rank);
+            ac = determinar_acao(mao, mao->bits, dealer_up_rank, contador->true_count);
         }
 
         switch (ac) {
@@ -268,17 +191,7 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
                 break;
             case ACAO_HIT:
                 registrar_acao(mao, 'H');
-                comprar_carta_e_adicionar(mao, shoe, running_count, true_count);
-                
-                // Atualizar shoe counter após carta distribuída
-                if (shoe_counter && shoe->topo > 0) {
-                    Carta ultima_carta = shoe->cartas[shoe->topo - 1];
-                    int rank_idx = carta_para_rank_idx(ultima_carta);
-                    if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter->counts[rank_idx] > 0) {
-                        shoe_counter->counts[rank_idx]--;
-                        shoe_counter->total_cards--;
-                    }
-                }
+                comprar_carta_e_adicionar(mao, shoe, contador);
                 
                 if (mao->valor >= 21) {
                     mao->finalizada = true;
@@ -289,34 +202,14 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
             case ACAO_DOUBLE_OR_STAND: {
                 if (!mao->from_split) {
                     registrar_acao(mao, 'D');
-                	comprar_carta_e_adicionar(mao, shoe, running_count, true_count);
-                    
-                    // Atualizar shoe counter após carta distribuída
-                    if (shoe_counter && shoe->topo > 0) {
-                        Carta ultima_carta = shoe->cartas[shoe->topo - 1];
-                        int rank_idx = carta_para_rank_idx(ultima_carta);
-                        if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter->counts[rank_idx] > 0) {
-                            shoe_counter->counts[rank_idx]--;
-                            shoe_counter->total_cards--;
-                        }
-                    }
+                	comprar_carta_e_adicionar(mao, shoe, contador);
                     
                     mao->finalizada = true;;
                     mao->isdouble = true;
                 } else {
                     if (ac == ACAO_DOUBLE_OR_HIT) {
                         registrar_acao(mao, 'H');
-		                comprar_carta_e_adicionar(mao, shoe, running_count, true_count);
-		                
-                        // Atualizar shoe counter após carta distribuída
-                        if (shoe_counter && shoe->topo > 0) {
-                            Carta ultima_carta = shoe->cartas[shoe->topo - 1];
-                            int rank_idx = carta_para_rank_idx(ultima_carta);
-                            if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter->counts[rank_idx] > 0) {
-                                shoe_counter->counts[rank_idx]--;
-                                shoe_counter->total_cards--;
-                            }
-                        }
+		                comprar_carta_e_adicionar(mao, shoe, contador);
                         
                         if (mao->valor >= 21) mao->finalizada = true;
                     } else { // fallback stand
@@ -339,7 +232,7 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
                 int ranks_present[2] = {-1, -1}; // armazenar os ranks das duas cartas caso não seja par natural
                 int cards_found = 0;
                 for (int idx = 0; idx < 13; ++idx) {
-                    uint64_t cnt = (mao->bits >> (idx * 3)) & 0x7ULL;
+                    int cnt = mao_bits_contagem(mao->bits, idx);
                     if (cnt == 0) continue;
 
                     if (cnt >= 2 && split_rank_idx_real == -1) {
@@ -369,7 +262,7 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
                     // não é possível splitar
                     if (ac == ACAO_SPLIT_OR_HIT) {
                         registrar_acao(mao, 'H');
-                        comprar_carta_e_adicionar(mao, shoe, running_count, true_count);
+                        comprar_carta_e_adicionar(mao, shoe, contador);
                     } else {
                         registrar_acao(mao, 'S');
                         mao->finalizada = true;
@@ -388,10 +281,9 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
                 }
 
                 // --- Passo 4: executar o split físico ---
-                uint64_t rank_bit = (uint64_t)1ULL << (split_rank_idx_real * 3);
+                uint64_t rank_bit = mao_bits_carta(split_rank_idx_real);
                 mao->bits -= rank_bit;                       // remover uma carta da mão original
-                mao->valor = calcular_valor_mao(mao->bits);  // atualizar valor/tipo
-                mao->tipo  = tipo_mao(mao->bits);
+                mao_estado_de_bits(mao, mao->bits);          // atualizar valor/tipo (1 carta)
 
                 // Inicializar nova mão com a carta removida
                 inicializar_mao(nova_mao_out, rank_bit, true);
@@ -400,8 +292,8 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
                 uint64_t original_split_bits = mao->initial_bits;
                 
                 // Dar uma carta adicional para cada mão
-                comprar_carta_e_adicionar(mao, shoe, running_count, true_count);
-                comprar_carta_e_adicionar(nova_mao_out, shoe, running_count, true_count);
+                comprar_carta_e_adicionar(mao, shoe, contador);
+                comprar_carta_e_adicionar(nova_mao_out, shoe, contador);
 
                 mao->from_split = true;
                 nova_mao_out->from_split = true;
@@ -411,12 +303,12 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
                 nova_mao_out->initial_bits = nova_mao_out->bits;
 
                 // Salvar índice de classificação (para estatísticas)
-                mao->split_rank_idx = split_rank_idx_class;
-                nova_mao_out->split_rank_idx = split_rank_idx_class;
+                mao->split_rank_idx = (int8_t)split_rank_idx_class;
+                nova_mao_out->split_rank_idx = (int8_t)split_rank_idx_class;
                 
                 // Salvar mão original
-                mao->original_split_bits = original_split_bits;
-                nova_mao_out->original_split_bits = original_split_bits;
+                if (mao->fria) mao->fria->original_split_bits = original_split_bits;
+                if (nova_mao_out->fria) nova_mao_out->fria->original_split_bits = original_split_bits;
 
                 // Debug removido do momento do split - será impresso no processamento final
 
@@ -438,10 +330,10 @@ Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out,
     return NULL;
 }
 
-void avaliar_mao_dealer(Mao *dealer, Shoe *shoe, double *running_count, double *true_count) {
-    while (dealer->valor < 17) {
+void avaliar_mao_dealer(Mao *dealer, Shoe *shoe, ContadorCartas *contador) {
+    while (!(fsm_atributos(dealer->estado)->flags & FSM_DEALER_PARA)) {
         registrar_acao(dealer, 'H');
-        comprar_carta_e_adicionar(dealer, shoe, running_count, true_count);
+        comprar_carta_e_adicionar(dealer, shoe, contador);
     }
     dealer->finalizada = true;
 }
@@ -449,17 +341,18 @@ void avaliar_mao_dealer(Mao *dealer, Shoe *shoe, double *running_count, double *
 void verificar_mao(Mao *jog, const Mao *dealer){
     // Assume dealer and jog have valor, blackjack updated
     char res = 'D';
+    bool jog_bust = fsm_atributos(jog->estado)->flags & FSM_BUST;
     if (dealer->blackjack){
         if (jog->blackjack) res = 'E';
         else res = 'D';
     } else {
         if (jog->blackjack) res = 'V';
         else {
-            if (dealer->valor > 21){
-                if (jog->valor <= 21) res = 'V';
+            if (fsm_atributos(dealer->estado)->flags & FSM_BUST){
+                if (!jog_bust) res = 'V';
                 else res = 'D';
             } else {
-                if (jog->valor > 21) res = 'D';
+                if (jog_bust) res = 'D';
                 else if (jog->valor == dealer->valor) res = 'E';
                 else if (jog->valor > dealer->valor) res = 'V';
                 else res = 'D';
@@ -527,10 +420,22 @@ static double _ajusta_unidades(double base, double tc, bool shoe_ok) {
     return (base < aposta_tc) ? aposta_tc : base;
 }
 
+void rampa_apostas_padrao(RampaApostas *rampa) {
+    for (int i = 0; i < 12; ++i) {
+        rampa->min_pct[i] = MIN_PCT[i];
+        rampa->apostas_base[i] = APOSTAS_BASE[i];
+    }
+}
+
 // Função para definir aposta baseada no sistema de progressão
-int definir_aposta(size_t cartas_restantes, int vitorias, double true_count, int maos_jogadas, double loss_shoe, double unidade_atual) {
+int definir_aposta(size_t cartas_restantes, int vitorias, double true_count, int maos_jogadas, double loss_shoe, double unidade_atual, const RampaApostas *rampa) {
     (void)loss_shoe; // Marcar como unused para evitar warning
     double resultado_aposta;
+    const double *min_pct = rampa ? rampa->min_pct : MIN_PCT;
+    const double *apostas_base = rampa ? rampa->apostas_base : APOSTAS_BASE;
+    
+    // Limites calibrados para 8 baralhos: cartas restantes na escala de 416 cartas
+    cartas_restantes = cartas_restantes * 8 / (size_t)DECKS;
     
     // Se shoe muito longo, apostar só 1 unidade
     if (cartas_restantes > (size_t)CARTAS_RESTANTES_LIMITE) {
@@ -542,12 +447,12 @@ int definir_aposta(size_t cartas_restantes, int vitorias, double true_count, int
         // Percorrer os blocos de condições (mantendo min_pct, min_len_shoe e min_true_count)
         bool encontrou_bloco = false;
         for (int i = 0; i < 12; ++i) {
-            if (pct_vit < MIN_PCT[i] && 
+            if (pct_vit < min_pct[i] && 
                 (int)cartas_restantes <= MIN_LEN_SHOE[i] && 
                 true_count >= MIN_TRUE_COUNT[i]) {
                 
                 // Usar aposta base diretamente do array APOSTAS_BASE
-                double base = APOSTAS_BASE[i];
+                double base = apostas_base[i];
                 
                 resultado_aposta = _ajusta_unidades(base, true_count, shoe_ok) * unidade_atual;
                 encontrou_bloco = true;
@@ -557,7 +462,7 @@ int definir_aposta(size_t cartas_restantes, int vitorias, double true_count, int
 
         if (!encontrou_bloco) {
             // Fallback genérico - usar a menor aposta base
-            double base = APOSTAS_BASE[11]; // última posição (2.0)
+            double base = apostas_base[11]; // última posição (2.0)
             resultado_aposta = _ajusta_unidades(base, true_count, shoe_ok) * unidade_atual;
         }
     }
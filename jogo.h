@@ -7,7 +7,7 @@
 #include "baralho.h"
 #include "constantes.h"
 #include "structures.h"  // Usar estruturas centralizadas
-#include "shoe_counter.h" // Para ShoeCounter
+#include "contador_cartas.h" // Cartas vistas: ShoeCounter, running/true count
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,45 +20,78 @@ typedef enum {
     MAO_BLACKJACK
 } TipoMao;
 
+// Dados frios de uma mão: histórico de ações e metadados de split. Só são
+// preenchidos quando há log (-l) ou análise de splits (-split); fora disso
+// Mao.fria fica NULL e o laço de jogo não toca nesta memória.
+typedef struct {
+    char historico[32];
+    int hist_len;
+    // Campos para análise de splits
+    int split_pair_index;   // Índice do par na análise de splits (-1 se não aplicável)
+    int split_upcard_index; // Índice do upcard na análise de splits (-1 se não aplicável)
+    int split_cards_used;   // Total de cartas usadas no split
+    uint64_t original_split_bits; // Mão original antes do split (apenas 2 cartas iniciais)
+} MaoFria;
+
+// Dados quentes de uma mão: o que o laço de jogo e a liquidação leem a cada
+// carta. Compacto (56 bytes) para que as mãos de uma rodada, guardadas em
+// sequência na arena por id de mão, caibam em poucas linhas de cache.
 typedef struct {
     uint64_t bits;
     uint64_t initial_bits;
-    int valor;
+    double aposta;
+    double pnl;
+    MaoFria *fria;          // NULL quando não há log nem análise de splits
+    // Estado do autômato de mãos (fsm_mao.h): cada carta avança o estado com
+    // uma leitura de tabela, sem varrer os 13 campos de bits
+    uint16_t estado;
+    uint8_t valor;
+    uint8_t tipo;           // TipoMao
     bool blackjack;
-    TipoMao tipo;
     bool finalizada;
     bool from_split;
     bool isdouble;
     bool contabilizada;
-    double aposta;
-    double pnl;
-    char historico[32];
-    int hist_len;
     char resultado;
-    // Campos para análise de splits
-    int split_pair_index;   // Índice do par na análise de splits (-1 se não aplicável)
-    int split_upcard_index; // Índice do upcard na análise de splits (-1 se não aplicável)
-    int split_cards_used;   // Total de cartas usadas no split
-    int split_rank_idx;     // Rank índice do par que foi dividido (-1 se não aplicável)
-    uint64_t original_split_bits; // Mão original antes do split (apenas 2 cartas iniciais)
+    int8_t split_rank_idx;  // Rank índice do par que foi dividido (-1 se não aplicável)
+    uint8_t num_acoes;      // Ações registradas (0 = mão inicial)
 } Mao;
 
+static inline void mao_fria_inicializar(MaoFria *fria) {
+    fria->historico[0] = '\0';
+    fria->hist_len = 0;
+    fria->split_pair_index = -1;
+    fria->split_upcard_index = -1;
+    fria->split_cards_used = 0;
+    fria->original_split_bits = 0;
+}
+
 int calcular_valor_mao(uint64_t mao);
 TipoMao tipo_mao(uint64_t mao);
 void avaliar_mao(uint64_t mao_bits, Mao *mao_out);
-AcaoEstrategia determinar_acao(const Mao *mao, uint64_t mao_bits, int dealer_up_rank);
+AcaoEstrategia determinar_acao(const Mao *mao, uint64_t mao_bits, int dealer_up_rank, double true_count);
 const char* acao_to_str(AcaoEstrategia a);
-void avaliar_mao_dealer(Mao *dealer, Shoe *shoe, double *running_count, double *true_count);
-// Função para jogar uma mão individual com ShoeCounter
+void avaliar_mao_dealer(Mao *dealer, Shoe *shoe, ContadorCartas *contador);
+// Função para jogar uma mão individual; cada carta comprada passa pelo
+// contador. Em split, a nova mão vai para nova_mao_out, que mantém o
+// ponteiro fria definido pelo chamador.
 Mao* jogar_mao(Mao *mao, Shoe *shoe, int dealer_up_rank, Mao *nova_mao_out, 
-               double *running_count, double *true_count, ShoeCounter *shoe_counter, bool ev_realtime_enabled);
+               ContadorCartas *contador, bool ev_realtime_enabled);
 
 void verificar_mao(Mao *jogador, const Mao *dealer);
 void calcular_pnl(Mao *mao);
 int calcular_maos_contabilizadas(double true_count);
 
+// Rampa de apostas (blocos de definir_aposta). NULL = MIN_PCT/APOSTAS_BASE de constantes.c
+typedef struct {
+    double min_pct[12];
+    double apostas_base[12];
+} RampaApostas;
+
+void rampa_apostas_padrao(RampaApostas *rampa);
+
 // Funções para sistema de apostas
-int definir_aposta(size_t cartas_restantes, int vitorias, double true_count, int maos_jogadas, double loss_shoe, double unidade_atual);
+int definir_aposta(size_t cartas_restantes, int vitorias, double true_count, int maos_jogadas, double loss_shoe, double unidade_atual, const RampaApostas *rampa);
 double calcular_unidade(double bankroll);
 
 #ifdef __cplusplus
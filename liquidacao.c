@@ -0,0 +1,88 @@
+#include "liquidacao.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+static inline void liquidar_intervalo(int inicio, int n, const int32_t *valor, const uint32_t *flags,
+                                      const double *aposta, int dealer_valor, uint32_t dealer_flags,
+                                      int32_t *resultado, double *pnl) {
+    for (int i = inicio; i < n; ++i) {
+        uint32_t f = flags[i];
+        int32_t r;
+        if (dealer_flags & LIQ_BLACKJACK) {
+            r = (f & LIQ_BLACKJACK) ? 0 : -1;
+        } else if (f & LIQ_BLACKJACK) {
+            r = 1;
+        } else if (f & LIQ_BUST) {
+            r = -1;
+        } else if (dealer_flags & LIQ_BUST) {
+            r = 1;
+        } else {
+            r = (valor[i] > dealer_valor) - (valor[i] < dealer_valor);
+        }
+        resultado[i] = r;
+
+        double multiplicador = (double)r;
+        if (f & LIQ_DOUBLE) multiplicador *= 2.0;
+        if (r == 1 && (f & LIQ_BLACKJACK)) multiplicador = 1.5;
+        pnl[i] = multiplicador * aposta[i];
+    }
+}
+
+void liquidar_maos_escalar(int n, const int32_t *valor, const uint32_t *flags, const double *aposta,
+                           int dealer_valor, uint32_t dealer_flags, int32_t *resultado, double *pnl) {
+    liquidar_intervalo(0, n, valor, flags, aposta, dealer_valor, dealer_flags, resultado, pnl);
+}
+
+void liquidar_maos(int n, const int32_t *valor, const uint32_t *flags, const double *aposta,
+                   int dealer_valor, uint32_t dealer_flags, int32_t *resultado, double *pnl) {
+    int i = 0;
+#if defined(__AVX2__)
+    // Condições do dealer valem para a rodada inteira: máscaras constantes
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i um = _mm256_set1_epi32(1);
+    const __m256i menos_um = _mm256_set1_epi32(-1);
+    const __m256i bit_bj = _mm256_set1_epi32(LIQ_BLACKJACK);
+    const __m256i bit_double = _mm256_set1_epi32(LIQ_DOUBLE);
+    const __m256i bit_bust = _mm256_set1_epi32(LIQ_BUST);
+    const __m256i dv = _mm256_set1_epi32(dealer_valor);
+    const __m256i dealer_bj = _mm256_set1_epi32((dealer_flags & LIQ_BLACKJACK) ? -1 : 0);
+    const __m256i dealer_bust = _mm256_set1_epi32((dealer_flags & LIQ_BUST) ? -1 : 0);
+    const __m256d dois = _mm256_set1_pd(2.0);
+    const __m256d um_e_meio = _mm256_set1_pd(1.5);
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(valor + i));
+        __m256i f = _mm256_loadu_si256((const __m256i*)(flags + i));
+        __m256i bj = _mm256_cmpeq_epi32(_mm256_and_si256(f, bit_bj), bit_bj);
+        __m256i dbl = _mm256_cmpeq_epi32(_mm256_and_si256(f, bit_double), bit_double);
+        __m256i bust = _mm256_cmpeq_epi32(_mm256_and_si256(f, bit_bust), bit_bust);
+
+        // Mesma precedência do caso escalar, aplicada de trás para frente:
+        // comparação de totais < dealer estourou < jogador estourou < BJ < BJ do dealer
+        __m256i r = _mm256_sub_epi32(_mm256_and_si256(_mm256_cmpgt_epi32(v, dv), um),
+                                     _mm256_and_si256(_mm256_cmpgt_epi32(dv, v), um));
+        r = _mm256_blendv_epi8(r, um, dealer_bust);
+        r = _mm256_blendv_epi8(r, menos_um, bust);
+        r = _mm256_blendv_epi8(r, um, bj);
+        r = _mm256_blendv_epi8(r, _mm256_blendv_epi8(menos_um, zero, bj), dealer_bj);
+        _mm256_storeu_si256((__m256i*)(resultado + i), r);
+
+        // Multiplicador da aposta: r, x2 com double, 1.5 em vitória de BJ
+        __m256i bj_vence = _mm256_and_si256(bj, _mm256_cmpeq_epi32(r, um));
+        for (int metade = 0; metade < 2; ++metade) {
+            __m128i r4 = metade ? _mm256_extracti128_si256(r, 1) : _mm256_castsi256_si128(r);
+            __m128i dbl4 = metade ? _mm256_extracti128_si256(dbl, 1) : _mm256_castsi256_si128(dbl);
+            __m128i bjv4 = metade ? _mm256_extracti128_si256(bj_vence, 1) : _mm256_castsi256_si128(bj_vence);
+            __m256d mult = _mm256_cvtepi32_pd(r4);
+            __m256d mascara_dbl = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(dbl4));
+            __m256d mascara_bjv = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(bjv4));
+            mult = _mm256_blendv_pd(mult, _mm256_mul_pd(mult, dois), mascara_dbl);
+            mult = _mm256_blendv_pd(mult, um_e_meio, mascara_bjv);
+            __m256d a = _mm256_loadu_pd(aposta + i + 4 * metade);
+            _mm256_storeu_pd(pnl + i + 4 * metade, _mm256_mul_pd(mult, a));
+        }
+    }
+#endif
+    liquidar_intervalo(i, n, valor, flags, aposta, dealer_valor, dealer_flags, resultado, pnl);
+}
@@ -0,0 +1,24 @@
+#ifndef LIQUIDACAO_H
+#define LIQUIDACAO_H
+
+#include <stdint.h>
+
+// Liquidação em lote das mãos de uma rodada contra o resultado do dealer.
+// Entrada em colunas (uma posição por id de mão): total, flags e aposta.
+// Saída: resultado (+1 vitória, 0 empate, -1 derrota) e PnL, com as mesmas
+// regras e os mesmos valores de verificar_mao + calcular_pnl (BJ paga 1.5,
+// double vale 2x). Com AVX2 processa 8 mãos por iteração com compare e
+// blend, sem desvios; o resto (ou builds sem AVX2) usa o laço escalar.
+
+#define LIQ_BLACKJACK 0x1u
+#define LIQ_DOUBLE    0x2u
+#define LIQ_BUST      0x4u
+
+void liquidar_maos(int n, const int32_t *valor, const uint32_t *flags, const double *aposta,
+                   int dealer_valor, uint32_t dealer_flags, int32_t *resultado, double *pnl);
+
+// Mesmo cálculo, sempre escalar (referência para testes e benchmark)
+void liquidar_maos_escalar(int n, const int32_t *valor, const uint32_t *flags, const double *aposta,
+                           int dealer_valor, uint32_t dealer_flags, int32_t *resultado, double *pnl);
+
+#endif // LIQUIDACAO_H
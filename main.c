@@ -3,7 +3,15 @@
 #include "constantes.h"
 #include "jogo.h"
 #include "structures.h"  // Usar estruturas centralizadas
+#include "rng.h"
 #include "realtime_strategy_integration.h"  // Para sistema de EV em tempo real
+#include "shoe_pipeline.h"  // Pipeline opcional de embaralhamento antecipado
+#include "shoe_corpus.h"    // Gravação/reprodução de shoes (-record-shoes/-replay-shoes)
+#include "comparacao_pareada.h" // Modo pareado com números aleatórios comuns (-crn)
+#include "reducao_variancia.h"  // Shoes antitéticos/estratificados (-vr)
+#include "desvios.h"            // Desvios de estratégia por true count (-desvios, -d)
+#include "estrategia_arquivo.h" // Estratégias básicas em arquivo (-estrategia, -crn est=)
+#include "acumulador_arquivo.h" // Contadores brutos das análises (-acum, merge)
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,89 +33,6 @@ bool debug_enabled = false;
 
 // Estruturas movidas para structures.h - removendo duplicações
 
-// Funções para arquivos binários com debugging e validação
-void write_dealer_binary(FILE* file, double true_count, int ace_upcard, int dealer_bj) {
-    if (!file) {
-        DEBUG_IO("ERRO: Tentativa de escrever em arquivo dealer NULL");
-        return;
-    }
-    
-    DEBUG_IO("Escrevendo dealer binary: TC=%.3f, Ace=%d, BJ=%d", true_count, ace_upcard, dealer_bj);
-    
-    DealerBinaryRecord record;
-    record.true_count = (float)true_count;
-    record.ace_upcard = ace_upcard;
-    record.dealer_bj = dealer_bj;
-    record.checksum = calculate_dealer_checksum(&record);
-    
-    size_t written = fwrite(&record, sizeof(record), 1, file);
-    if (written != 1) {
-        DEBUG_IO("ERRO: Falha ao escrever registro dealer (escrito=%zu, esperado=1)", written);
-    } else {
-        DEBUG_IO("Registro dealer escrito com sucesso: %zu bytes", sizeof(record));
-    }
-}
-
-void write_split_binary(FILE* file, double true_count, int lose_lose, int win_win, int push_push,
-                       int lose_win, int lose_push, int win_lose, int win_push, 
-                       int push_lose, int push_win, int cards_used) {
-    if (!file) {
-        DEBUG_IO("ERRO: Tentativa de escrever em arquivo split NULL");
-        return;
-    }
-    
-    DEBUG_IO("Escrevendo split binary: TC=%.3f, Cards=%d", true_count, cards_used);
-    DEBUG_STATS("Split combinations: LL=%d WW=%d PP=%d LW=%d LP=%d WL=%d WP=%d PL=%d PW=%d", 
-               lose_lose, win_win, push_push, lose_win, lose_push, win_lose, win_push, push_lose, push_win);
-    
-    SplitBinaryRecord record;
-    record.true_count = (float)true_count;
-    record.lose_lose = lose_lose;
-    record.win_win = win_win;
-    record.push_push = push_push;
-    record.lose_win = lose_win;
-    record.lose_push = lose_push;
-    record.win_lose = win_lose;
-    record.win_push = win_push;
-    record.push_lose = push_lose;
-    record.push_win = push_win;
-    record.cards_used = cards_used;
-    record.checksum = calculate_split_checksum(&record);
-    
-    // Validar antes de escrever
-    if (!validate_split_record(&record)) {
-        DEBUG_IO("ERRO: Registro split inválido, não será escrito");
-        return;
-    }
-    
-    size_t written = fwrite(&record, sizeof(record), 1, file);
-    if (written != 1) {
-        DEBUG_IO("ERRO: Falha ao escrever registro split (escrito=%zu, esperado=1)", written);
-    } else {
-        DEBUG_IO("Registro split escrito com sucesso: %zu bytes", sizeof(record));
-    }
-}
-
-void write_freq_binary(FILE* file, double true_count) {
-    if (!file) {
-        DEBUG_IO("ERRO: Tentativa de escrever em arquivo freq NULL");
-        return;
-    }
-    
-    DEBUG_IO("Escrevendo freq binary: TC=%.3f", true_count);
-    
-    FreqBinaryRecord record;
-    record.true_count = (float)true_count;
-    record.checksum = calculate_freq_checksum(&record);
-    
-    size_t written = fwrite(&record, sizeof(record), 1, file);
-    if (written != 1) {
-        DEBUG_IO("ERRO: Falha ao escrever registro freq (escrito=%zu, esperado=1)", written);
-    } else {
-        DEBUG_IO("Registro freq escrito com sucesso: %zu bytes", sizeof(record));
-    }
-}
-
 // Estrutura para passar dados para as threads
 typedef struct {
     int log_level;
@@ -122,11 +47,13 @@ typedef struct {
     bool freq_analysis_A;
     bool split_analysis;
     bool ev_realtime_enabled;
-    pthread_mutex_t* dealer_mutex;
-    pthread_mutex_t* freq_mutex;
-    pthread_mutex_t* split_mutex;
     bool insurance_analysis;
-    pthread_mutex_t* insurance_mutex;
+    uint64_t rng_seed;
+    bool lazy_shuffle;
+    ShoeRing* shoe_ring;  // NULL = worker embaralha os próprios shoes
+    ComparacaoPareada* crn; // NULL = modo normal
+    ReducaoVariancia* vr;   // NULL = Monte Carlo simples
+    UnidadesThread unidades; // Resultado em unidades das simulações da thread (preenchido ao fim)
     // Cache line padding para evitar false sharing
     char padding[64];
 } __attribute__((aligned(64))) ThreadData;
@@ -142,8 +69,8 @@ static struct timeval start_time;
 typedef struct {
     double tc_min;
     double tc_max;
-    int total_ace_upcards;
-    int dealer_blackjacks;
+    uint64_t total_ace_upcards;
+    uint64_t dealer_blackjacks;
     double percentage;
 } BinData;
 
@@ -176,9 +103,8 @@ void show_progress(int current, int total, double elapsed_time) {
 // Função movida para structures.h como get_bin_index_robust
 
 // Função para processar dados do dealer e gerar CSV
-void process_dealer_data(int num_sims, const char* output_suffix) {
+void process_dealer_data(const char* output_suffix) {
     DEBUG_PRINT("Iniciando processamento de dados do dealer");
-    DEBUG_STATS("Total de simulações: %d", num_sims);
     
     BinData bins[MAX_BINS];
     
@@ -192,73 +118,21 @@ void process_dealer_data(int num_sims, const char* output_suffix) {
         DEBUG_IO("Diretório ./Resultados criado");
     }
     
-    // Inicializar bins
+    // Inicializar bins com os totais acumulados pelas threads
     for (int i = 0; i < MAX_BINS; i++) {
+        AsBin acumulado = simulacao_dealer_bj_bin(i);
         bins[i].tc_min = MIN_TC + i * BIN_WIDTH;
         bins[i].tc_max = bins[i].tc_min + BIN_WIDTH;
-        bins[i].total_ace_upcards = 0;
-        bins[i].dealer_blackjacks = 0;
+        bins[i].total_ace_upcards = acumulado.ases;
+        bins[i].dealer_blackjacks = acumulado.blackjacks;
         bins[i].percentage = 0.0;
     }
     DEBUG_STATS("Inicializados %d bins de %.1f a %.1f com largura %.1f", 
                MAX_BINS, MIN_TC, MAX_TC, BIN_WIDTH);
     
-    // Processar arquivos temporários binários por lote (CORRIGIDO: usar DEALER_BATCH_SIZE)
-    int num_batches = (num_sims + DEALER_BATCH_SIZE - 1) / DEALER_BATCH_SIZE;  
-    DEBUG_STATS("Processando %d lotes de %d simulações cada", num_batches, DEALER_BATCH_SIZE);
-    
-    for (int batch = 0; batch < num_batches; batch++) {
-        char temp_filename[256];
-        snprintf(temp_filename, sizeof(temp_filename), "%s%d%s", DEALER_TEMP_FILE_PREFIX, batch, BINARY_SUFFIX);
-        
-        DEBUG_IO("Processando lote %d: %s", batch, temp_filename);
-        
-        // Verificar integridade do arquivo
-        if (!verify_file_integrity(temp_filename, sizeof(DealerBinaryRecord))) {
-            DEBUG_IO("Arquivo %s falhou na verificação de integridade, pulando", temp_filename);
-            continue;
-        }
-        
-        FILE* temp_file = fopen(temp_filename, "rb");
-        if (!temp_file) {
-            DEBUG_IO("Não foi possível abrir arquivo: %s", temp_filename);
-            continue;
-        }
-        
-        int records_processed = 0;
-        int valid_records = 0;
-        DealerBinaryRecord record;
-        
-        while (fread(&record, sizeof(record), 1, temp_file) == 1) {
-            records_processed++;
-            
-            // Validar registro
-            if (!validate_dealer_record(&record)) {
-                DEBUG_STATS("Registro inválido no lote %d, posição %d", batch, records_processed);
-                continue;
-            }
-            
-            valid_records++;
-            
-            if (record.ace_upcard == 1) { // Só processar quando upcard é Ás
-                int bin_idx = get_bin_index_robust(record.true_count);
-                if (bin_idx >= 0 && bin_idx < MAX_BINS) {
-                    bins[bin_idx].total_ace_upcards++;
-                    bins[bin_idx].dealer_blackjacks += record.dealer_bj;
-                }
-            }
-        }
-        
-        fclose(temp_file);
-        unlink(temp_filename); // Remover arquivo temporário
-        
-        DEBUG_STATS("Lote %d processado: %d registros lidos, %d válidos", 
-                   batch, records_processed, valid_records);
-    }
-    
     // Calcular percentuais
-    int total_ace_situations = 0;
-    int total_dealer_bjs = 0;
+    uint64_t total_ace_situations = 0;
+    uint64_t total_dealer_bjs = 0;
     
     for (int i = 0; i < MAX_BINS; i++) {
         if (bins[i].total_ace_upcards > 0) {
@@ -268,8 +142,8 @@ void process_dealer_data(int num_sims, const char* output_suffix) {
         }
     }
     
-    DEBUG_STATS("Total de situações com upcard Ás: %d", total_ace_situations);
-    DEBUG_STATS("Total de dealer blackjacks: %d", total_dealer_bjs);
+    DEBUG_STATS("Total de situações com upcard Ás: %llu", (unsigned long long)total_ace_situations);
+    DEBUG_STATS("Total de dealer blackjacks: %llu", (unsigned long long)total_dealer_bjs);
     if (total_ace_situations > 0) {
         DEBUG_STATS("Percentual geral de dealer BJ com upcard Ás: %.2f%%", 
                    (double)total_dealer_bjs / total_ace_situations * 100.0);
@@ -293,9 +167,10 @@ void process_dealer_data(int num_sims, const char* output_suffix) {
     for (int i = 0; i < MAX_BINS; i++) {
         if (bins[i].total_ace_upcards > 0) {
             double tc_center = bins[i].tc_min + BIN_WIDTH / 2.0;
-            fprintf(csv_file, "%.2f,%.2f,%.2f,%d,%d,%.4f\n",
+            fprintf(csv_file, "%.2f,%.2f,%.2f,%llu,%llu,%.4f\n",
                    bins[i].tc_min, bins[i].tc_max, tc_center,
-                   bins[i].total_ace_upcards, bins[i].dealer_blackjacks, bins[i].percentage);
+                   (unsigned long long)bins[i].total_ace_upcards,
+                   (unsigned long long)bins[i].dealer_blackjacks, bins[i].percentage);
             bins_with_data++;
         }
     }
@@ -316,8 +191,20 @@ void* worker_thread(void* arg) {
     int local_completed = 0;
     const int update_interval = 100; // Atualizar progresso a cada 100 simulações
     
+    shoe_pipeline_set_ring(data->shoe_ring);
+    if (data->vr) {
+        simulacao_set_variante(NULL, vr_buffer_thread(data->vr, data->thread_id));
+    }
+    
     for (int i = data->sim_start; i < data->sim_end; ++i) {
-        simulacao_completa(data->log_level, i, data->output_suffix, data->global_log_count, data->dealer_analysis, data->freq_analysis_26, data->freq_analysis_70, data->freq_analysis_A, data->split_analysis, data->ev_realtime_enabled, data->dealer_mutex, data->freq_mutex, data->split_mutex, data->insurance_analysis, data->insurance_mutex);
+        if (data->crn) {
+            crn_executar_simulacao(data->crn, data->thread_id, i, data->global_log_count, data->rng_seed);
+        } else {
+            simulacao_completa(data->log_level, i, data->output_suffix, data->global_log_count, data->dealer_analysis, data->freq_analysis_26, data->freq_analysis_70, data->freq_analysis_A, data->split_analysis, data->ev_realtime_enabled, data->insurance_analysis, data->rng_seed, data->lazy_shuffle);
+            if (data->vr) {
+                vr_acumular_simulacao(data->vr, data->thread_id);
+            }
+        }
         
         local_completed++;
         
@@ -358,6 +245,15 @@ void* worker_thread(void* arg) {
         }
     }
     
+    baralho_liberar_thread();
+    contador_cartas_liberar_thread();
+    vr_liberar_thread();
+    desvios_acumular_thread();
+    simulacao_freq_acumular_thread();
+    simulacao_split_acumular_thread();
+    simulacao_as_acumular_thread();
+    simulacao_unidades_coletar_thread(&data->unidades);
+    
     return NULL;
 }
 
@@ -375,20 +271,58 @@ void print_usage(const char* program_name) {
     printf("  -histA      Ativar análise de frequência para upcard A do dealer\n");
     printf("  -split      Ativar análise de resultados de splits\n");
     printf("  -ev         Ativar EV em tempo real (desativado por padrão)\n");
+    printf("  -dealer     Ativar análise de blackjack do dealer com upcard Ás vs TC\n");
     printf("  -ins        Ativar análise de insurance\n");
+    printf("  -seed <num> Semente do RNG (mesma semente = mesmos shoes por sim_id) [default: relógio]\n");
+    printf("  -lazy       Embaralhar sob demanda: um passo de Fisher-Yates por carta comprada\n");
+    printf("  -full-kernel Usar o núcleo completo mesmo sem análises, log ou EV (comparação de desempenho)\n");
+    printf("  -shufflers <num> Threads que pré-embaralham shoes para os workers [default: 0 = desativado]\n");
+    printf("  -ring <num> Shoes prontos por worker no pipeline (back-pressure) [default: 8]\n");
+    printf("  -record-shoes <arq> Gravar todos os shoes embaralhados em um corpus binário\n");
+    printf("  -replay-shoes <arq> Jogar os shoes de um corpus gravado (mmap) em vez de embaralhar\n");
+    printf("  -crn <variantes> Comparação pareada sobre os mesmos shoes: bs|ev[:pct=X][:base=Y][:est=arq],...\n");
+    printf("              (pct/base multiplicam MIN_PCT/APOSTAS_BASE; est troca a estratégia básica;\n");
+    printf("              diferenças vs a primeira variante)\n");
+    printf("  -config <arq> Regras da mesa em arquivo 'chave = valor' (decks, penetracao, jogadores, shoes, out_dir)\n");
+    printf("  -decks <num> Baralhos no shoe [default: 8]\n");
+    printf("  -pen <frac> Penetração (fração do shoe distribuída) [default: 0.5]\n");
+    printf("  -jogadores <num> Jogadores na mesa, 1 a 7 [default: 4]\n");
+    printf("  -shoes <num> Shoes por simulação [default: 1000]\n");
+    printf("  -out-dir <dir> Diretório dos logs CSV\n");
+    printf("              (as opções de regra são aplicadas na ordem: a última vence)\n");
+    printf("  -vr <esquema> Redução de variância nos shoes: antitetico-reverso, antitetico-complemento\n");
+    printf("              ou estratificado (relata o ganho de amostra efetiva vs Monte Carlo simples)\n");
+    printf("  -estrategia <arq> Estratégia básica em arquivo texto (compilada uma vez; cache binário em <dir>/.cache)\n");
+    printf("  -desvios <arq> Desvios de estratégia por true count ('<hard|soft|par> <valor> <upcard> <>=|<> <tc> <ação>')\n");
+    printf("  -d          Desativar desvios de estratégia (ativos por padrão quando há regras carregadas)\n");
+    printf("  -acum <arq> Gravar os contadores brutos das análises ativas (somáveis com o subcomando merge)\n");
     printf("  -h          Mostrar esta ajuda\n\n");
+    printf("Subcomando:\n");
+    printf("  %s merge [-o <suffix>] [-acum <saida>] <arq> [<arq> ...]\n", program_name);
+    printf("              Soma arquivos de -acum da mesma mesa, estratégia e desvios e regenera os CSVs das análises\n\n");
     printf("Exemplos:\n");
     printf("  %s -l 0 -n 1000        # Rodar 1000 simulações sem log\n", program_name);
     printf("  %s -l 1000 -n 100      # Rodar 100 simulações salvando 1000 linhas total\n", program_name);
     printf("  %s -n 10000 -t 8       # Rodar 10000 simulações com 8 threads\n", program_name);
     printf("  %s -l 500 -o teste     # Salvar 500 linhas total como log_teste.csv\n", program_name);
-    // Comentado: exemplo de uso -dealer
+    printf("  %s -dealer -n 10000 -o analysis # Dealer BJ com upcard Ás vs TC\n", program_name);
     printf("  %s -hist26 -n 10000 -o analysis # Análise de frequência 2-6 vs TC\n", program_name);
     printf("  %s -hist70 -n 10000 -o analysis # Análise de frequência 7-10 vs TC\n", program_name);
     printf("  %s -histA -n 10000 -o analysis # Análise de frequência A vs TC\n", program_name);
     printf("  %s -split -n 50000 -o split_test # Análise de resultados de splits\n", program_name);
     printf("  %s -ev -n 10000 -o ev_test # Usar EV em tempo real\n", program_name);
     printf("  %s -ins -n 10000 -o ins_test # Análise de insurance\n", program_name);
+    printf("  %s -seed 42 -n 1000 -t 32 # Execução reproduzível\n", program_name);
+    printf("  %s -n 10000 -t 16 -shufflers 4 -ring 16 # Embaralhamento antecipado em 4 threads\n", program_name);
+    printf("  %s -seed 7 -n 1000 -record-shoes shoes.bin # Gravar corpus de shoes\n", program_name);
+    printf("  %s -n 1000 -replay-shoes shoes.bin # Rodar outra build sobre os mesmos shoes\n", program_name);
+    printf("  %s -n 2000 -crn bs,ev # EV em tempo real vs estratégia básica nos mesmos shoes\n", program_name);
+    printf("  %s -n 2000 -crn bs,bs:base=0.8 # Duas rampas de apostas nos mesmos shoes\n", program_name);
+    printf("  %s -n 1000 -decks 6 -pen 0.75 -jogadores 7 # Outra mesa sem recompilar\n", program_name);
+    printf("  %s -config mesa.cfg -n 1000 # Regras lidas de arquivo\n", program_name);
+    printf("  %s -n 2000 -vr antitetico-complemento # Pares de shoes com cartas baixas/altas trocadas\n", program_name);
+    printf("  %s -split -hist26 -n 500000 -seed 1 -acum noite1.acum # Contadores para merge\n", program_name);
+    printf("  %s merge -o 3M noite*.acum # CSVs *_3M a partir das execuções somadas\n", program_name);
 }
 
 // Função para concatenar arquivos de log e limpar arquivos individuais
@@ -396,9 +330,8 @@ void print_usage(const char* program_name) {
 
 
 // Função para processar dados de split
-void process_split_data(int num_sims, const char* output_suffix) {
+void process_split_data(const char* output_suffix) {
     DEBUG_PRINT("Iniciando processamento de dados de split");
-    DEBUG_STATS("Total de simulações: %d", num_sims);
     
     // Criar diretório Resultados se não existir
     struct stat st = {0};
@@ -413,106 +346,13 @@ void process_split_data(int num_sims, const char* output_suffix) {
     // Todos os pares: AA, 1010, 99, 88, 77, 66, 55, 44, 33, 22
     // Removidos JJ, QQ, KK conforme solicitado
     const char* pairs[] = {"AA", "1010", "99", "88", "77", "66", "55", "44", "33", "22"};
-    const int pair_ranks[] = {12, 8, 7, 6, 5, 4, 3, 2, 1, 0}; // índices 0-9 para A,10,9,8,7,6,5,4,3,2
-    (void)pair_ranks; // evitar warning de variável não usada
     
     // Todas as upcards: 2, 3, 4, 5, 6, 7, 8, 9, 10, A
     const char* upcards[] = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "A"};
-    const int upcard_ranks[] = {2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
-    (void)upcard_ranks;
-    
-    // Processar cada combinação de par e upcard
-    for (int p = 0; p < 10; p++) {
-        for (int u = 0; u < 10; u++) {
-            // Estrutura para acumular dados por bin (CORRIGIDA)
-            typedef struct {
-                double tc_min, tc_max;
-                int total_splits;
-                // Combinações reais de resultados
-                int lose_lose, win_win, push_push;
-                int lose_win, lose_push, win_lose;
-                int win_push, push_lose, push_win;
-                int total_cards_used;
-                double total_cards_squared; // Para desvio padrão
-            } SplitBinData;
-            
-            SplitBinData bins[MAX_BINS];
-            
-            // Inicializar bins
-            for (int i = 0; i < MAX_BINS; i++) {
-                bins[i].tc_min = MIN_TC + i * BIN_WIDTH;
-                bins[i].tc_max = bins[i].tc_min + BIN_WIDTH;
-                bins[i].total_splits = 0;
-                bins[i].lose_lose = bins[i].win_win = bins[i].push_push = 0;
-                bins[i].lose_win = bins[i].lose_push = bins[i].win_lose = 0;
-                bins[i].win_push = bins[i].push_lose = bins[i].push_win = 0;
-                bins[i].total_cards_used = 0;
-                bins[i].total_cards_squared = 0.0;
-            }
-            
-            // Processar arquivos temporários binários por lote (CORRIGIDO: usar SPLIT_BATCH_SIZE)
-            int num_batches = (num_sims + SPLIT_BATCH_SIZE - 1) / SPLIT_BATCH_SIZE;
-            DEBUG_STATS("Processando %d lotes de splits para %s vs %s", num_batches, pairs[p], upcards[u]);
-            
-            for (int batch = 0; batch < num_batches; batch++) {
-                char temp_filename[512];
-                snprintf(temp_filename, sizeof(temp_filename), "%s%d_%s_vs_%s%s", 
-                        SPLIT_TEMP_FILE_PREFIX, batch, pairs[p], upcards[u], BINARY_SUFFIX);
-                
-                DEBUG_IO("Processando arquivo split: %s", temp_filename);
-                
-                // Verificar integridade do arquivo
-                if (!verify_file_integrity(temp_filename, sizeof(SplitBinaryRecord))) {
-                    DEBUG_IO("Arquivo %s falhou na verificação de integridade, pulando", temp_filename);
-                    continue;
-                }
-                
-                FILE* temp_file = fopen(temp_filename, "rb");
-                if (!temp_file) {
-                    DEBUG_IO("Não foi possível abrir arquivo: %s", temp_filename);
-                    continue;
-                }
-                
-                int records_processed = 0;
-                int valid_records = 0;
-                SplitBinaryRecord record;
-                
-                while (fread(&record, sizeof(record), 1, temp_file) == 1) {
-                    records_processed++;
-                    
-                    // Validar usando a função robusta
-                    if (!validate_split_record(&record)) {
-                        DEBUG_STATS("Registro split inválido no lote %d, posição %d para %s vs %s", 
-                                   batch, records_processed, pairs[p], upcards[u]);
-                        continue;
-                    }
-                    
-                    valid_records++;
-                    
-                    int bin_idx = get_bin_index_robust(record.true_count);
-                    if (bin_idx >= 0 && bin_idx < MAX_BINS) {
-                        bins[bin_idx].total_splits++;
-                        bins[bin_idx].lose_lose += record.lose_lose;
-                        bins[bin_idx].win_win += record.win_win;
-                        bins[bin_idx].push_push += record.push_push;
-                        bins[bin_idx].lose_win += record.lose_win;
-                        bins[bin_idx].lose_push += record.lose_push;
-                        bins[bin_idx].win_lose += record.win_lose;
-                        bins[bin_idx].win_push += record.win_push;
-                        bins[bin_idx].push_lose += record.push_lose;
-                        bins[bin_idx].push_win += record.push_win;
-                        bins[bin_idx].total_cards_used += record.cards_used;
-                        bins[bin_idx].total_cards_squared += (double)(record.cards_used * record.cards_used);
-                    }
-                }
-                
-                fclose(temp_file);
-                unlink(temp_filename); // Remover arquivo temporário
-                
-                DEBUG_STATS("Lote %d de split %s vs %s processado: %d registros lidos, %d válidos", 
-                           batch, pairs[p], upcards[u], records_processed, valid_records);
-            }
-            
+    
+    // Processar cada combinação de par e upcard a partir dos acumuladores das threads
+    for (int p = 0; p < SPLIT_PARES; p++) {
+        for (int u = 0; u < SPLIT_UPCARDS; u++) {
             // Gerar CSV final
             char csv_filename[512];
             if (output_suffix) {
@@ -534,43 +374,37 @@ void process_split_data(int num_sims, const char* output_suffix) {
             
             // Processar cada bin
             for (int i = 0; i < MAX_BINS; i++) {
-                if (bins[i].total_splits >= 1) { // Amostra mínima
-                    // Calcular totais das duas mãos
-                    int total_hands = bins[i].total_splits * 2; // Cada split produz 2 mãos
-                    double tc_center = bins[i].tc_min + BIN_WIDTH / 2.0;
+                SplitBin bin;
+                simulacao_split_bin(p, u, i, &bin);
+                if (bin.splits >= 1) { // Amostra mínima
+                    double tc_min = MIN_TC + i * BIN_WIDTH;
+                    double tc_max = tc_min + BIN_WIDTH;
+                    double tc_center = tc_min + BIN_WIDTH / 2.0;
+                    uint64_t total_splits = bin.splits;
+                    uint64_t total_hands = total_splits * 2; // Cada split produz 2 mãos
                     
-                    // Calcular frequências das combinações (MÉTODO CORRETO)
-                    int total_splits = bins[i].total_splits;
-                    if (total_splits > 0) {
-                        // Usar contagens reais das combinações ao invés de multiplicar probabilidades
-                        double freq_lose_lose = (double)bins[i].lose_lose / total_splits;
-                        double freq_win_win = (double)bins[i].win_win / total_splits;
-                        double freq_push_push = (double)bins[i].push_push / total_splits;
-                        double freq_lose_win = (double)bins[i].lose_win / total_splits;
-                        double freq_lose_push = (double)bins[i].lose_push / total_splits;
-                        double freq_win_lose = (double)bins[i].win_lose / total_splits;
-                        double freq_win_push = (double)bins[i].win_push / total_splits;
-                        double freq_push_lose = (double)bins[i].push_lose / total_splits;
-                        double freq_push_win = (double)bins[i].push_win / total_splits;
-                        
-                        // Calcular expected value CORRIGIDO: considerar todas as 9 combinações
-                        // EV = -2*P(lose/lose) + 2*P(win/win) + 0*P(push/push) + 0*P(lose/win) 
-                        //      + (-1)*P(lose/push) + 0*P(win/lose) + 1*P(win/push) + (-1)*P(push/lose) + 1*P(push/win)
-                        double expected_value = -2.0 * freq_lose_lose + 2.0 * freq_win_win 
-                                               - freq_lose_push + freq_win_push 
-                                               - freq_push_lose + freq_push_win;
-                        
-                        // Calcular estatísticas de cartas
-                        double avg_cards = (double)bins[i].total_cards_used / bins[i].total_splits;
-                        double variance = (bins[i].total_cards_squared / bins[i].total_splits) - (avg_cards * avg_cards);
-                        double std_cards = sqrt(variance > 0 ? variance : 0);
-                        
-                        fprintf(csv_file, "%.2f,%.2f,%.2f,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.2f,%.2f\n",
-                               bins[i].tc_min, bins[i].tc_max, tc_center, total_splits, total_hands,
-                               freq_lose_lose, freq_win_win, freq_push_push, freq_lose_win, freq_lose_push,
-                               freq_win_lose, freq_win_push, freq_push_lose, freq_push_win, expected_value,
-                               avg_cards, std_cards);
+                    // Frequências das combinações reais (LL, WW, PP, LW, LP, WL, WP, PL, PW)
+                    double freq[SPLIT_COMBINACOES];
+                    for (int c = 0; c < SPLIT_COMBINACOES; c++) {
+                        freq[c] = (double)bin.combinacoes[c] / total_splits;
                     }
+                    
+                    // EV = -2*P(lose/lose) + 2*P(win/win) + 0*P(push/push) + 0*P(lose/win) 
+                    //      + (-1)*P(lose/push) + 0*P(win/lose) + 1*P(win/push) + (-1)*P(push/lose) + 1*P(push/win)
+                    double expected_value = -2.0 * freq[0] + 2.0 * freq[1] 
+                                           - freq[4] + freq[6] 
+                                           - freq[7] + freq[8];
+                    
+                    // Calcular estatísticas de cartas
+                    double avg_cards = (double)bin.cartas / total_splits;
+                    double variance = ((double)bin.cartas_quadrado / total_splits) - (avg_cards * avg_cards);
+                    double std_cards = sqrt(variance > 0 ? variance : 0);
+                    
+                    fprintf(csv_file, "%.2f,%.2f,%.2f,%llu,%llu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.2f,%.2f\n",
+                           tc_min, tc_max, tc_center, (unsigned long long)total_splits, (unsigned long long)total_hands,
+                           freq[0], freq[1], freq[2], freq[3], freq[4],
+                           freq[5], freq[6], freq[7], freq[8], expected_value,
+                           avg_cards, std_cards);
                 }
             }
             
@@ -581,8 +415,45 @@ void process_split_data(int num_sims, const char* output_suffix) {
     printf("Análise de splits concluída!\n");
 }
 
-// Função para processar dados de frequência do dealer
-void process_frequency_data(int num_sims, const char* output_suffix, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A) {
+// Grava um CSV de frequência do dealer (upcard_idx 0..8 = 2..10, 9 = A) a
+// partir dos histogramas acumulados pelas threads
+static void escrever_csv_frequencia(int upcard_idx, int final_val, const char* output_suffix) {
+    const char* upcard_names[] = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "A"};
+    const char* final_names[] = {"17", "18", "19", "20", "21", "BJ", "BUST"};
+    
+    char csv_filename[512];
+    if (output_suffix) {
+        snprintf(csv_filename, sizeof(csv_filename), "./Resultados/freq_%s_%s_%s.csv", upcard_names[upcard_idx], final_names[final_val], output_suffix);
+    } else {
+        snprintf(csv_filename, sizeof(csv_filename), "./Resultados/freq_%s_%s_sim.csv", upcard_names[upcard_idx], final_names[final_val]);
+    }
+    
+    FILE* csv_file = fopen(csv_filename, "w");
+    if (!csv_file) {
+        fprintf(stderr, "Erro ao criar arquivo CSV de frequência: %s\n", csv_filename);
+        return;
+    }
+    
+    fprintf(csv_file, "true_count_min,true_count_max,true_count_center,total_upcard_count,final_count,frequency\n");
+    
+    for (int i = 0; i < MAX_BINS; i++) {
+        uint64_t total = simulacao_freq_total(upcard_idx, i);
+        if (total > 0) {
+            uint64_t final_count = simulacao_freq_final(upcard_idx, final_val, i);
+            double tc_min = MIN_TC + i * BIN_WIDTH;
+            double tc_max = tc_min + BIN_WIDTH;
+            double tc_center = tc_min + BIN_WIDTH / 2.0;
+            double frequency = (double)final_count / total * 100.0;
+            fprintf(csv_file, "%.2f,%.2f,%.2f,%llu,%llu,%.4f\n",
+                   tc_min, tc_max, tc_center,
+                   (unsigned long long)total, (unsigned long long)final_count, frequency);
+        }
+    }
+    
+    fclose(csv_file);
+}
+
+void process_frequency_data(const char* output_suffix, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A) {
     if (!freq_analysis_26 && !freq_analysis_70 && !freq_analysis_A) {
         return; // Nenhuma análise de frequência ativada
     }
@@ -596,12 +467,8 @@ void process_frequency_data(int num_sims, const char* output_suffix, bool freq_a
         }
     }
     
-    const char* upcard_names[] = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "A"};
-    const char* final_names[] = {"17", "18", "19", "20", "21", "BJ", "BUST"};
-    
     // Determinar quais upcards processar
     int start_upcard = 11, end_upcard = 1; // Valores inválidos = nenhum upcard por padrão
-    bool include_ace = false;
     
     if (freq_analysis_26 && freq_analysis_70) {
         // Ambos ativos: 2-6 e 7-10 = 2-10
@@ -614,258 +481,19 @@ void process_frequency_data(int num_sims, const char* output_suffix, bool freq_a
         start_upcard = 7; end_upcard = 10;
     }
     
-    if (freq_analysis_A) {
-        include_ace = true;
-    }
-    
-    // Processar cada upcard
     for (int upcard = start_upcard; upcard <= end_upcard; upcard++) {
-        // Estrutura para acumular dados de total por bin para este upcard
-        typedef struct {
-            double tc_min, tc_max;
-            int total_upcard_count;
-        } TotalBinData;
-        
-        TotalBinData total_bins[MAX_BINS];
-        
-        // Inicializar bins de total
-        for (int i = 0; i < MAX_BINS; i++) {
-            total_bins[i].tc_min = MIN_TC + i * BIN_WIDTH;
-            total_bins[i].tc_max = total_bins[i].tc_min + BIN_WIDTH;
-            total_bins[i].total_upcard_count = 0;
-        }
-        
-        // Carregar dados de total para este upcard
-        int num_batches = (num_sims + 19999) / 20000;  // Ceil division para 20k por lote
-        for (int batch = 0; batch < num_batches; batch++) {
-            char total_filename[512];
-            snprintf(total_filename, sizeof(total_filename), "temp_total_upcard_%d_batch_%d%s", upcard, batch, BINARY_SUFFIX);
-            
-            FILE* total_file = fopen(total_filename, "rb");
-            if (!total_file) continue;
-            
-            FreqBinaryRecord record;
-            while (fread(&record, sizeof(record), 1, total_file) == 1) {
-                int bin_idx = (int)((record.true_count - MIN_TC) / BIN_WIDTH);
-                if (bin_idx >= 0 && bin_idx < MAX_BINS) {
-                    total_bins[bin_idx].total_upcard_count++;
-                }
-            }
-            
-            fclose(total_file);
-        }
-        
-        // Agora processar cada valor final para este upcard
-        for (int final_val = 0; final_val < 7; final_val++) {
-            // Estrutura para acumular dados por bin
-            typedef struct {
-                double tc_min, tc_max;
-                int final_count;
-                double frequency;
-            } FreqBinData;
-            
-            FreqBinData bins[MAX_BINS];
-            
-            // Inicializar bins usando dados de total já carregados
-            for (int i = 0; i < MAX_BINS; i++) {
-                bins[i].tc_min = total_bins[i].tc_min;
-                bins[i].tc_max = total_bins[i].tc_max;
-                bins[i].final_count = 0;
-                bins[i].frequency = 0.0;
-            }
-            
-            // Processar arquivo de resultado específico para este upcard/final
-            // Pular arquivos BJ para upcards que não podem ter blackjack (2-9)
+        for (int final_val = 0; final_val < FREQ_FINAIS; final_val++) {
+            // Sem CSV de BJ para upcards que não podem ter blackjack (2-9)
             if (final_val == 5 && upcard != 10) {
-                continue; // Não processar arquivo BJ inexistente para upcards 2-9
-            }
-            
-            for (int batch = 0; batch < num_batches; batch++) {
-                char result_filename[512];
-                snprintf(result_filename, sizeof(result_filename), "temp_result_upcard_%d_final_%s_batch_%d%s", upcard, final_names[final_val], batch, BINARY_SUFFIX);
-                
-                FILE* result_file = fopen(result_filename, "rb");
-                if (!result_file) continue;
-                
-                FreqBinaryRecord record;
-                while (fread(&record, sizeof(record), 1, result_file) == 1) {
-                    int bin_idx = (int)((record.true_count - MIN_TC) / BIN_WIDTH);
-                    if (bin_idx >= 0 && bin_idx < MAX_BINS) {
-                        bins[bin_idx].final_count++;
-                    }
-                }
-                
-                fclose(result_file);
-                unlink(result_filename); // Remover arquivo temporário de resultado
-            }
-            
-            // Calcular frequências
-            for (int i = 0; i < MAX_BINS; i++) {
-                if (total_bins[i].total_upcard_count > 0) {
-                    bins[i].frequency = (double)bins[i].final_count / total_bins[i].total_upcard_count * 100.0;
-                }
-            }
-            
-            // Gerar CSV final apenas se há dados ou se não é arquivo BJ inválido
-            if (final_val == 5 && upcard != 10) {
-                // Não gerar arquivo CSV BJ para upcards 2-9 (sempre vazios)
                 continue;
             }
-            
-            char csv_filename[512];
-            if (output_suffix) {
-                snprintf(csv_filename, sizeof(csv_filename), "./Resultados/freq_%s_%s_%s.csv", upcard_names[upcard-2], final_names[final_val], output_suffix);
-            } else {
-                snprintf(csv_filename, sizeof(csv_filename), "./Resultados/freq_%s_%s_sim.csv", upcard_names[upcard-2], final_names[final_val]);
-            }
-            
-            FILE* csv_file = fopen(csv_filename, "w");
-            if (!csv_file) {
-                fprintf(stderr, "Erro ao criar arquivo CSV de frequência: %s\n", csv_filename);
-                continue;
-            }
-            
-            fprintf(csv_file, "true_count_min,true_count_max,true_count_center,total_upcard_count,final_count,frequency\n");
-            
-            for (int i = 0; i < MAX_BINS; i++) {
-                if (total_bins[i].total_upcard_count > 0) {
-                    double tc_center = bins[i].tc_min + BIN_WIDTH / 2.0;
-                    fprintf(csv_file, "%.2f,%.2f,%.2f,%d,%d,%.4f\n",
-                           bins[i].tc_min, bins[i].tc_max, tc_center,
-                           total_bins[i].total_upcard_count, bins[i].final_count, bins[i].frequency);
-                }
-            }
-            
-            fclose(csv_file);
+            escrever_csv_frequencia(upcard - 2, final_val, output_suffix);
         }
     }
     
-    // Remover arquivos de total para upcards 2-10 após processar todos os finais
-    for (int upcard = start_upcard; upcard <= end_upcard; upcard++) {
-        int num_batches = (num_sims + 19999) / 20000;
-        for (int batch = 0; batch < num_batches; batch++) {
-            char total_filename[512];
-            snprintf(total_filename, sizeof(total_filename), "temp_total_upcard_%d_batch_%d%s", upcard, batch, BINARY_SUFFIX);
-            unlink(total_filename);
-        }
-    }
-    
-    // Processar upcard A se necessário
-    if (include_ace) {
-        // Estrutura para acumular dados de total por bin para upcard A
-        typedef struct {
-            double tc_min, tc_max;
-            int total_upcard_count;
-        } TotalBinData;
-        
-        TotalBinData total_bins[MAX_BINS];
-        
-        // Inicializar bins de total
-        for (int i = 0; i < MAX_BINS; i++) {
-            total_bins[i].tc_min = MIN_TC + i * BIN_WIDTH;
-            total_bins[i].tc_max = total_bins[i].tc_min + BIN_WIDTH;
-            total_bins[i].total_upcard_count = 0;
-        }
-        
-        // Carregar dados de total para upcard A
-        int num_batches = (num_sims + 19999) / 20000;  // Ceil division para 20k por lote
-        for (int batch = 0; batch < num_batches; batch++) {
-            char total_filename[512];
-            snprintf(total_filename, sizeof(total_filename), "temp_total_upcard_A_batch_%d%s", batch, BINARY_SUFFIX);
-            
-            FILE* total_file = fopen(total_filename, "rb");
-            if (!total_file) continue;
-            
-            FreqBinaryRecord record;
-            while (fread(&record, sizeof(record), 1, total_file) == 1) {
-                int bin_idx = (int)((record.true_count - MIN_TC) / BIN_WIDTH);
-                if (bin_idx >= 0 && bin_idx < MAX_BINS) {
-                    total_bins[bin_idx].total_upcard_count++;
-                }
-            }
-            
-            fclose(total_file);
-        }
-        
-        // Agora processar cada valor final para upcard A
-        for (int final_val = 0; final_val < 7; final_val++) {
-            // Estrutura para acumular dados por bin
-            typedef struct {
-                double tc_min, tc_max;
-                int final_count;
-                double frequency;
-            } FreqBinData;
-            
-            FreqBinData bins[MAX_BINS];
-            
-            // Inicializar bins usando dados de total já carregados
-            for (int i = 0; i < MAX_BINS; i++) {
-                bins[i].tc_min = total_bins[i].tc_min;
-                bins[i].tc_max = total_bins[i].tc_max;
-                bins[i].final_count = 0;
-                bins[i].frequency = 0.0;
-            }
-            
-            // Processar arquivo de resultado específico para upcard A/final
-            for (int batch = 0; batch < num_batches; batch++) {
-                char result_filename[512];
-                snprintf(result_filename, sizeof(result_filename), "temp_result_upcard_A_final_%s_batch_%d%s", final_names[final_val], batch, BINARY_SUFFIX);
-                
-                FILE* result_file = fopen(result_filename, "rb");
-                if (!result_file) continue;
-                
-                FreqBinaryRecord record;
-                while (fread(&record, sizeof(record), 1, result_file) == 1) {
-                    int bin_idx = (int)((record.true_count - MIN_TC) / BIN_WIDTH);
-                    if (bin_idx >= 0 && bin_idx < MAX_BINS) {
-                        bins[bin_idx].final_count++;
-                    }
-                }
-                
-                fclose(result_file);
-                unlink(result_filename); // Remover arquivo temporário de resultado
-            }
-            
-            // Calcular frequências
-            for (int i = 0; i < MAX_BINS; i++) {
-                if (total_bins[i].total_upcard_count > 0) {
-                    bins[i].frequency = (double)bins[i].final_count / total_bins[i].total_upcard_count * 100.0;
-                }
-            }
-            
-            // Gerar CSV final
-            char csv_filename[512];
-            if (output_suffix) {
-                snprintf(csv_filename, sizeof(csv_filename), "./Resultados/freq_A_%s_%s.csv", final_names[final_val], output_suffix);
-            } else {
-                snprintf(csv_filename, sizeof(csv_filename), "./Resultados/freq_A_%s_sim.csv", final_names[final_val]);
-            }
-            
-            FILE* csv_file = fopen(csv_filename, "w");
-            if (!csv_file) {
-                fprintf(stderr, "Erro ao criar arquivo CSV de frequência: %s\n", csv_filename);
-                continue;
-            }
-            
-            fprintf(csv_file, "true_count_min,true_count_max,true_count_center,total_upcard_count,final_count,frequency\n");
-            
-            for (int i = 0; i < MAX_BINS; i++) {
-                if (total_bins[i].total_upcard_count > 0) {
-                    double tc_center = bins[i].tc_min + BIN_WIDTH / 2.0;
-                    fprintf(csv_file, "%.2f,%.2f,%.2f,%d,%d,%.4f\n",
-                           bins[i].tc_min, bins[i].tc_max, tc_center,
-                           total_bins[i].total_upcard_count, bins[i].final_count, bins[i].frequency);
-                }
-            }
-            
-            fclose(csv_file);
-        }
-        
-        // Remover arquivos de total para upcard A após processar todos os finais
-        for (int batch = 0; batch < num_batches; batch++) {
-            char total_filename[512];
-            snprintf(total_filename, sizeof(total_filename), "temp_total_upcard_A_batch_%d%s", batch, BINARY_SUFFIX);
-            unlink(total_filename);
+    if (freq_analysis_A) {
+        for (int final_val = 0; final_val < FREQ_FINAIS; final_val++) {
+            escrever_csv_frequencia(9, final_val, output_suffix);
         }
     }
     
@@ -1002,7 +630,7 @@ void concatenate_and_cleanup_logs(int num_sims, const char* output_suffix) {
     fclose(final_file);
 }
 
-void process_insurance_data(int num_sims, const char* output_suffix) {
+void process_insurance_data(const char* output_suffix) {
     printf("Processando dados de análise de insurance...\n");
     
     // Criar diretório se não existir
@@ -1011,89 +639,32 @@ void process_insurance_data(int num_sims, const char* output_suffix) {
         mkdir(OUT_DIR, 0700);
     }
     
-    // Definir bins para porcentagem de cartas de rank 10 (30% a 40% em bins de 0.1%)
-    const int NUM_INSURANCE_BINS = 101; // (40% - 30%) / 0.1% = 100 bins + 1
+    // Bins de porcentagem de cartas de rank 10 (30% a 40% em bins de 0.1%)
     const double INSURANCE_BIN_WIDTH = 0.001; // 0.1%
-    const double MIN_PERCENTAGE = 0.30; // 30%
+    const double MIN_PERCENTAGE = INSURANCE_MIN_PERMIL / 1000.0; // 30%
 
-    
-                typedef struct {
-                double percentage_min;
-                double percentage_max;
-                int total_ace_upcards;
-                int dealer_blackjacks;
-                double blackjack_frequency;
-            } InsuranceBin;
-    
-    InsuranceBin bins[NUM_INSURANCE_BINS];
-    
-    // Inicializar bins
-    for (int i = 0; i < NUM_INSURANCE_BINS; i++) {
+    typedef struct {
+        double percentage_min;
+        double percentage_max;
+        uint64_t total_ace_upcards;
+        uint64_t dealer_blackjacks;
+        double blackjack_frequency;
+    } InsuranceBin;
+    
+    InsuranceBin bins[INSURANCE_BINS];
+    
+    // Inicializar bins com os totais acumulados pelas threads
+    for (int i = 0; i < INSURANCE_BINS; i++) {
+        AsBin acumulado = simulacao_insurance_bin(i);
         bins[i].percentage_min = MIN_PERCENTAGE + i * INSURANCE_BIN_WIDTH;
         bins[i].percentage_max = MIN_PERCENTAGE + (i + 1) * INSURANCE_BIN_WIDTH;
-        bins[i].total_ace_upcards = 0;
-        bins[i].dealer_blackjacks = 0;
+        bins[i].total_ace_upcards = acumulado.ases;
+        bins[i].dealer_blackjacks = acumulado.blackjacks;
         bins[i].blackjack_frequency = 0.0;
     }
     
-    // Calcular número de lotes
-    int num_batches = (num_sims + 19999) / 20000; // Arredondar para cima
-    
-    printf("Processando %d lotes de insurance...\n", num_batches);
-    
-    // Processar cada lote
-    for (int batch = 0; batch < num_batches; batch++) {
-        char temp_filename[512];
-        snprintf(temp_filename, sizeof(temp_filename), "%s%d%s", INSURANCE_TEMP_FILE_PREFIX, batch, BINARY_SUFFIX);
-        
-        DEBUG_IO("Processando arquivo insurance: %s", temp_filename);
-        
-        // Verificar integridade do arquivo
-        if (!verify_file_integrity(temp_filename, sizeof(InsuranceBinaryRecord))) {
-            DEBUG_IO("Arquivo %s falhou na verificação de integridade, pulando", temp_filename);
-            continue;
-        }
-        
-        FILE* temp_file = fopen(temp_filename, "rb");
-        if (!temp_file) {
-            DEBUG_IO("Não foi possível abrir arquivo: %s", temp_filename);
-            continue;
-        }
-        
-        int records_processed = 0;
-        int valid_records = 0;
-        InsuranceBinaryRecord record;
-        
-        while (fread(&record, sizeof(record), 1, temp_file) == 1) {
-            records_processed++;
-            
-            // Validar usando a função robusta
-            if (!validate_insurance_record(&record)) {
-                DEBUG_STATS("Registro insurance inválido no lote %d, posição %d", batch, records_processed);
-                continue;
-            }
-            
-            valid_records++;
-            
-            // Calcular bin baseado na porcentagem de cartas de rank 10
-            double percentage = (double)record.ten_cards_percentage;
-            int bin_idx = (int)((percentage - MIN_PERCENTAGE) / INSURANCE_BIN_WIDTH);
-            
-            if (bin_idx >= 0 && bin_idx < NUM_INSURANCE_BINS) {
-                bins[bin_idx].total_ace_upcards++;
-                bins[bin_idx].dealer_blackjacks += record.dealer_blackjack;
-            }
-        }
-        
-        fclose(temp_file);
-        unlink(temp_filename); // Remover arquivo temporário
-        
-        DEBUG_STATS("Lote %d de insurance processado: %d registros lidos, %d válidos", 
-                   batch, records_processed, valid_records);
-    }
-    
     // Calcular frequências
-    for (int i = 0; i < NUM_INSURANCE_BINS; i++) {
+    for (int i = 0; i < INSURANCE_BINS; i++) {
         if (bins[i].total_ace_upcards > 0) {
             bins[i].blackjack_frequency = (double)bins[i].dealer_blackjacks / bins[i].total_ace_upcards;
         }
@@ -1117,12 +688,12 @@ void process_insurance_data(int num_sims, const char* output_suffix) {
     fprintf(csv_file, "Percentage_Min,Percentage_Max,Total_Ace_Upcards,Dealer_Blackjacks,Blackjack_Frequency\n");
     
     // Dados
-    for (int i = 0; i < NUM_INSURANCE_BINS; i++) {
-        fprintf(csv_file, "%.3f,%.3f,%d,%d,%.6f\n",
+    for (int i = 0; i < INSURANCE_BINS; i++) {
+        fprintf(csv_file, "%.3f,%.3f,%llu,%llu,%.6f\n",
                 bins[i].percentage_min * 100.0, // Converter para porcentagem
                 bins[i].percentage_max * 100.0, // Converter para porcentagem
-                bins[i].total_ace_upcards,
-                bins[i].dealer_blackjacks,
+                (unsigned long long)bins[i].total_ace_upcards,
+                (unsigned long long)bins[i].dealer_blackjacks,
                 bins[i].blackjack_frequency);
     }
     
@@ -1131,6 +702,132 @@ void process_insurance_data(int num_sims, const char* output_suffix) {
     printf("Análise de insurance salva em: %s\n", csv_filename);
 }
 
+// Distribuição das unidades por simulação e por thread
+static void imprimir_unidades(const UnidadesThread* total, const ThreadData* thread_data, int num_threads) {
+    const EstatisticaOnline* por_sim = &total->por_sim;
+    if (por_sim->n == 0) return;
+    double desvio = sqrt(estatistica_variancia(por_sim));
+    printf("  Unidades por simulação: média %.2f, desvio %.2f, mín %.2f, máx %.2f (EP da média %.3f)\n",
+           por_sim->media, desvio, total->minimo_sim, total->maximo_sim, desvio / sqrt((double)por_sim->n));
+    
+    if (num_threads <= 1) return;
+    if (num_threads <= 16) {
+        printf("  Unidades por thread:\n");
+        for (int i = 0; i < num_threads; i++) {
+            const UnidadesThread* u = &thread_data[i].unidades;
+            printf("    Thread %2d: %llu simulações, total %.2f, média %.2f por simulação\n", i,
+                   (unsigned long long)u->por_sim.n, soma_compensada_valor(&u->total), u->por_sim.media);
+        }
+    } else {
+        double menor = 0.0, maior = 0.0;
+        bool primeira = true;
+        for (int i = 0; i < num_threads; i++) {
+            const UnidadesThread* u = &thread_data[i].unidades;
+            if (u->por_sim.n == 0) continue;
+            if (primeira || u->por_sim.media < menor) menor = u->por_sim.media;
+            if (primeira || u->por_sim.media > maior) maior = u->por_sim.media;
+            primeira = false;
+        }
+        printf("  Média por simulação entre threads: %.2f a %.2f\n", menor, maior);
+    }
+}
+
+// Máscara ACUM_* das análises ativas na execução
+static uint32_t analises_ativas(bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool dealer_analysis, bool insurance_analysis) {
+    return (freq_analysis_26 ? ACUM_FREQ_26 : 0) | (freq_analysis_70 ? ACUM_FREQ_70 : 0) |
+           (freq_analysis_A ? ACUM_FREQ_A : 0) | (split_analysis ? ACUM_SPLIT : 0) |
+           (dealer_analysis ? ACUM_DEALER : 0) | (insurance_analysis ? ACUM_INSURANCE : 0);
+}
+
+// Gera os CSVs das análises da máscara a partir dos totais acumulados
+static void processar_analises(uint32_t analises, const char* output_suffix) {
+    bool freq_26 = analises & ACUM_FREQ_26, freq_70 = analises & ACUM_FREQ_70, freq_A = analises & ACUM_FREQ_A;
+    if (freq_26 || freq_70 || freq_A) {
+        printf("Processando dados de análise de frequência...\n");
+        process_frequency_data(output_suffix, freq_26, freq_70, freq_A);
+    }
+    if (analises & ACUM_SPLIT) {
+        printf("Processando dados de análise de splits...\n");
+        process_split_data(output_suffix);
+    }
+    if (analises & ACUM_DEALER) {
+        printf("Processando dados de análise de dealer blackjack...\n");
+        process_dealer_data(output_suffix);
+    }
+    if (analises & ACUM_INSURANCE) {
+        process_insurance_data(output_suffix);
+    }
+}
+
+// Subcomando merge: soma arquivos de acumuladores (mesma mesa, estratégia e
+// desvios) e regenera os CSVs de todas as análises presentes em algum deles
+static int executar_merge(const char* program_name, int argc, char* argv[]) {
+    static const char* nomes_analises[ACUM_NUM_ANALISES] = {
+        "freq 2-6", "freq 7-10", "freq A", "split", "dealer BJ", "insurance"
+    };
+    const char* output_suffix = NULL;
+    const char* arquivo_saida = NULL;
+    AcumuladorHeader total;
+    int num_arquivos = 0;
+    
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_suffix = argv[++i];
+        } else if (strcmp(argv[i], "-acum") == 0 && i + 1 < argc) {
+            arquivo_saida = argv[++i];
+        } else if (strcmp(argv[i], "-debug") == 0) {
+            debug_enabled = true;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "Opção inválida para merge: %s. Use -h para ajuda.\n", argv[i]);
+            return 1;
+        } else {
+            AcumuladorHeader h;
+            if (acumulador_somar_arquivo(argv[i], &h) != 0) return 1;
+            if (num_arquivos == 0) {
+                total = h;
+            } else if (!acumulador_compativeis(&total, &h)) {
+                if (h.estrategia_hash != total.estrategia_hash || h.desvios_hash != total.desvios_hash) {
+                    fprintf(stderr, "Erro: %s foi jogado com outra estratégia ou outros desvios "
+                            "(estratégia %016llx, desvios %016llx; esperado %016llx, %016llx)\n",
+                            argv[i], (unsigned long long)h.estrategia_hash, (unsigned long long)h.desvios_hash,
+                            (unsigned long long)total.estrategia_hash, (unsigned long long)total.desvios_hash);
+                } else {
+                    fprintf(stderr, "Erro: %s é de outra mesa (%u decks, %u jogadores, penetração %.4f; esperado %u, %u, %.4f)\n",
+                            argv[i], h.decks, h.jogadores, h.penetracao_ppm * 1e-6,
+                            total.decks, total.jogadores, total.penetracao_ppm * 1e-6);
+                }
+                return 1;
+            } else {
+                acumulador_header_somar(&total, &h);
+            }
+            num_arquivos++;
+            printf("  %s: %llu simulações\n", argv[i], (unsigned long long)h.num_sims);
+        }
+    }
+    
+    if (num_arquivos == 0) {
+        fprintf(stderr, "Uso: %s merge [-o <suffix>] [-acum <saida>] <arq> [<arq> ...]\n", program_name);
+        return 1;
+    }
+    printf("Merge de %d arquivos: %llu simulações (%u decks, %u jogadores, penetração %.4f)\n",
+           num_arquivos, (unsigned long long)total.num_sims, total.decks, total.jogadores,
+           total.penetracao_ppm * 1e-6);
+    // Cada análise soma só as execuções que a tinham ativa
+    for (int a = 0; a < ACUM_NUM_ANALISES; ++a) {
+        if (total.analises & (1u << a)) {
+            printf("  %-10s %llu simulações\n", nomes_analises[a], (unsigned long long)total.sims_por_analise[a]);
+        }
+    }
+    
+    processar_analises(total.analises, output_suffix);
+    
+    if (arquivo_saida) {
+        if (acumulador_gravar(arquivo_saida, &total) != 0) return 1;
+        printf("Acumuladores somados salvos em: %s\n", arquivo_saida);
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     int log_level = 0;
     int num_sims = NUM_SIMS;
@@ -1143,6 +840,23 @@ int main(int argc, char* argv[]) {
     bool split_analysis = false;   // Análise de resultados de splits
     bool ev_realtime_enabled = false; // EV em tempo real desativado por padrão
     bool insurance_analysis = false; // Análise de insurance desativada por padrão
+    uint64_t semente_rng = rng_seed_from_clock(); // Sobrescrita por -seed para execuções reproduzíveis
+    bool lazy_shuffle = false; // Embaralhamento sob demanda (só as cartas distribuídas)
+    bool nucleo_completo = false; // -full-kernel: desativa o núcleo enxuto
+    int num_embaralhadoras = 0; // Threads de embaralhamento antecipado (0 = desativado)
+    int capacidade_ring = 8;    // Shoes prontos por worker (back-pressure)
+    const char* arquivo_gravar_shoes = NULL;     // -record-shoes
+    const char* arquivo_reproduzir_shoes = NULL; // -replay-shoes
+    const char* spec_crn = NULL; // -crn: variantes jogadas sobre os mesmos shoes
+    EsquemaVR esquema_vr = VR_NENHUM; // -vr: esquema de redução de variância
+    const char* arquivo_desvios = NULL; // -desvios: regras de desvio por true count
+    const char* arquivo_estrategia = NULL; // -estrategia: estratégia básica em arquivo
+    bool desativar_desvios = false;     // -d
+    const char* arquivo_acumulador = NULL; // -acum: contadores brutos das análises
+    
+    if (argc > 1 && strcmp(argv[1], "merge") == 0) {
+        return executar_merge(argv[0], argc - 2, argv + 2);
+    }
     
     // Processar argumentos da linha de comando
     for (int i = 1; i < argc; i++) {
@@ -1164,9 +878,61 @@ int main(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "-ev") == 0) {
             ev_realtime_enabled = true;
             DEBUG_PRINT("EV em tempo real ativado");
+        } else if (strcmp(argv[i], "-dealer") == 0) {
+            dealer_analysis = true;
+            DEBUG_PRINT("Análise de dealer blackjack ativada");
         } else if (strcmp(argv[i], "-ins") == 0) {
             insurance_analysis = true;
             DEBUG_PRINT("Análise de insurance ativada");
+        } else if (strcmp(argv[i], "-lazy") == 0) {
+            lazy_shuffle = true;
+            DEBUG_PRINT("Embaralhamento sob demanda ativado");
+        } else if (strcmp(argv[i], "-full-kernel") == 0) {
+            nucleo_completo = true;
+        } else if (strcmp(argv[i], "-shufflers") == 0 && i + 1 < argc) {
+            num_embaralhadoras = atoi(argv[++i]);
+            if (num_embaralhadoras < 0) {
+                fprintf(stderr, "Erro: Número de embaralhadoras deve ser >= 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-ring") == 0 && i + 1 < argc) {
+            capacidade_ring = atoi(argv[++i]);
+            if (capacidade_ring <= 0) {
+                fprintf(stderr, "Erro: Capacidade do ring deve ser > 0\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-record-shoes") == 0 && i + 1 < argc) {
+            arquivo_gravar_shoes = argv[++i];
+        } else if (strcmp(argv[i], "-replay-shoes") == 0 && i + 1 < argc) {
+            arquivo_reproduzir_shoes = argv[++i];
+        } else if (strcmp(argv[i], "-crn") == 0 && i + 1 < argc) {
+            spec_crn = argv[++i];
+        } else if (strcmp(argv[i], "-config") == 0 && i + 1 < argc) {
+            if (constantes_carregar_arquivo(argv[++i]) != 0) {
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-decks") == 0 && i + 1 < argc) {
+            if (constantes_definir("decks", argv[++i]) != 0) return 1;
+        } else if (strcmp(argv[i], "-pen") == 0 && i + 1 < argc) {
+            if (constantes_definir("penetracao", argv[++i]) != 0) return 1;
+        } else if (strcmp(argv[i], "-jogadores") == 0 && i + 1 < argc) {
+            if (constantes_definir("jogadores", argv[++i]) != 0) return 1;
+        } else if (strcmp(argv[i], "-shoes") == 0 && i + 1 < argc) {
+            if (constantes_definir("shoes", argv[++i]) != 0) return 1;
+        } else if (strcmp(argv[i], "-out-dir") == 0 && i + 1 < argc) {
+            if (constantes_definir("out_dir", argv[++i]) != 0) return 1;
+        } else if (strcmp(argv[i], "-vr") == 0 && i + 1 < argc) {
+            if (vr_parse(argv[++i], &esquema_vr) != 0) {
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-estrategia") == 0 && i + 1 < argc) {
+            arquivo_estrategia = argv[++i];
+        } else if (strcmp(argv[i], "-desvios") == 0 && i + 1 < argc) {
+            arquivo_desvios = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0) {
+            desativar_desvios = true;
+        } else if (strcmp(argv[i], "-acum") == 0 && i + 1 < argc) {
+            arquivo_acumulador = argv[++i];
         } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
             log_level = atoi(argv[++i]);
             if (log_level < 0) {
@@ -1185,6 +951,13 @@ int main(int argc, char* argv[]) {
                 fprintf(stderr, "Erro: Número de threads deve ser > 0\n");
                 return 1;
             }
+        } else if ((strcmp(argv[i], "-seed") == 0 || strcmp(argv[i], "--seed") == 0) && i + 1 < argc) {
+            char* fim = NULL;
+            semente_rng = strtoull(argv[++i], &fim, 0);
+            if (!fim || *fim != '\0') {
+                fprintf(stderr, "Erro: Semente inválida: %s\n", argv[i]);
+                return 1;
+            }
         } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
             output_suffix = argv[++i];
         } else if (strcmp(argv[i], "-h") == 0) {
@@ -1196,67 +969,141 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    // Configurar variáveis globais
-    total_sims = num_sims;
-    completed_sims = 0;
-    
-    // Inicializar variável global de unidades totais
-    unidades_total_global = 0.0;
+    if (lazy_shuffle && num_embaralhadoras > 0) {
+        fprintf(stderr, "Erro: -lazy e -shufflers são incompatíveis (o pipeline entrega shoes já embaralhados)\n");
+        return 1;
+    }
     
-    // Contador global de linhas de log (thread-safe)
-    atomic_int global_log_count = 0;
+    if (arquivo_gravar_shoes && arquivo_reproduzir_shoes) {
+        fprintf(stderr, "Erro: -record-shoes e -replay-shoes não podem ser usados juntos\n");
+        return 1;
+    }
+    if (arquivo_gravar_shoes && lazy_shuffle) {
+        fprintf(stderr, "Erro: -record-shoes requer o shoe inteiro embaralhado (incompatível com -lazy)\n");
+        return 1;
+    }
+    if (arquivo_gravar_shoes && log_level > 0) {
+        fprintf(stderr, "Erro: -record-shoes requer -l 0 (o limite de log interrompe as simulações e deixa shoes sem gravar)\n");
+        return 1;
+    }
+    if (arquivo_reproduzir_shoes && (lazy_shuffle || num_embaralhadoras > 0)) {
+        fprintf(stderr, "Erro: -replay-shoes não embaralha (incompatível com -lazy e -shufflers)\n");
+        return 1;
+    }
     
-    // Mutex para proteger escritas no arquivo de dealer
-    pthread_mutex_t dealer_mutex;
-    if (dealer_analysis) {
-        if (pthread_mutex_init(&dealer_mutex, NULL) != 0) {
-            fprintf(stderr, "Erro ao inicializar mutex\n");
+    ComparacaoPareada comparacao;
+    ComparacaoPareada* crn = NULL;
+    if (spec_crn) {
+        if (crn_parse_variantes(spec_crn, &comparacao) != 0) {
             return 1;
         }
-    }
-    
-    // Mutex para proteger escritas nos arquivos de frequência
-    pthread_mutex_t freq_mutex;
-    bool any_freq_analysis = freq_analysis_26 || freq_analysis_70 || freq_analysis_A;
-    if (any_freq_analysis) {
-        if (pthread_mutex_init(&freq_mutex, NULL) != 0) {
-            fprintf(stderr, "Erro ao inicializar mutex de frequência\n");
+        if (lazy_shuffle || num_embaralhadoras > 0) {
+            fprintf(stderr, "Erro: -crn joga cada shoe várias vezes (incompatível com -lazy e -shufflers)\n");
             return 1;
         }
+        crn = &comparacao;
     }
     
-
-    
-    // Mutex para proteger escritas nos arquivos de split
-    pthread_mutex_t split_mutex;
-    if (split_analysis) {
-        if (pthread_mutex_init(&split_mutex, NULL) != 0) {
-            fprintf(stderr, "Erro ao inicializar mutex de split\n");
+    // Os esquemas geram os shoes no próprio worker e precisam de todos os
+    // shoes de cada simulação (o limite de -l encerra as simulações no meio)
+    if (esquema_vr != VR_NENHUM) {
+        if (lazy_shuffle || num_embaralhadoras > 0 || arquivo_reproduzir_shoes || crn) {
+            fprintf(stderr, "Erro: -vr gera os próprios shoes (incompatível com -lazy, -shufflers, -replay-shoes e -crn)\n");
+            return 1;
+        }
+        if (log_level > 0) {
+            fprintf(stderr, "Erro: -vr requer -l 0 (o limite de log interrompe as simulações)\n");
             return 1;
         }
     }
     
-    // Mutex para proteger escritas nos arquivos de insurance
-    pthread_mutex_t insurance_mutex;
-    if (insurance_analysis) {
-        if (pthread_mutex_init(&insurance_mutex, NULL) != 0) {
-            fprintf(stderr, "Erro ao inicializar mutex de insurance\n");
+    // Corpus de shoes: aberto antes das threads e compartilhado (somente pwrite/leitura)
+    ShoeCorpus* shoe_corpus = NULL;
+    if (arquivo_gravar_shoes) {
+        shoe_corpus = shoe_corpus_criar(arquivo_gravar_shoes, semente_rng, num_sims);
+        if (!shoe_corpus) return 1;
+    } else if (arquivo_reproduzir_shoes) {
+        shoe_corpus = shoe_corpus_abrir(arquivo_reproduzir_shoes);
+        if (!shoe_corpus) return 1;
+        const ShoeCorpusHeader* h = shoe_corpus_header(shoe_corpus);
+        if ((uint64_t)num_sims * NUM_SHOES > h->num_shoes) {
+            fprintf(stderr, "Erro: corpus %s tem %llu shoes, insuficiente para %d simulações\n",
+                    arquivo_reproduzir_shoes, (unsigned long long)h->num_shoes, num_sims);
+            shoe_corpus_fechar(shoe_corpus);
             return 1;
         }
+        semente_rng = h->semente; // informativo: shoes vêm do corpus
     }
+    shoe_corpus_set_ativo(shoe_corpus);
+    
+    // Configurar variáveis globais
+    total_sims = num_sims;
+    completed_sims = 0;
+    
+    // Contador global de linhas de log (thread-safe)
+    atomic_int global_log_count = 0;
+    
+    // Estratégia básica em arquivo: compilada (ou lida do cache) antes das threads
+    const EstrategiaCompilada* estrategia = NULL;
+    if (arquivo_estrategia) {
+        estrategia = estrategia_carregar(arquivo_estrategia);
+        if (!estrategia) return 1;
+        estrategia_set_padrao(estrategia_tabela(estrategia));
+    }
+    
+    // Desvios: tabelas compiladas antes das threads (somente leitura depois)
+    if (arquivo_desvios && desvios_carregar_arquivo(arquivo_desvios) != 0) {
+        return 1;
+    }
+    desvios_set_habilitados(!desativar_desvios);
+    simulacao_set_nucleo_completo(nucleo_completo);
     
     // Mostrar configuração
     printf("Simulador de Blackjack - Configuração:\n");
     printf("  Simulações: %d\n", num_sims);
     printf("  Shoes por simulação: %d\n", NUM_SHOES);
+    printf("  Mesa: %d baralhos, penetração %.0f%%, %d jogadores (%s)\n", DECKS, PENETRACAO * 100.0, NUM_JOGADORES,
+           simulacao_especializada() ? "laço especializado" : "laço genérico");
     printf("  Threads: %d\n", num_threads);
-    printf("  Estratégia: %s\n", ev_realtime_enabled ? "EV em tempo real" : "Estratégia básica");
+    if (crn) {
+        printf("  Modo pareado (CRN): %d variantes (%s)\n", crn->num_variantes, spec_crn);
+    } else {
+        printf("  Estratégia: %s\n", ev_realtime_enabled ? "EV em tempo real" : "Estratégia básica");
+        printf("  Núcleo: %s\n", simulacao_nucleo_enxuto(log_level, dealer_analysis, freq_analysis_26, freq_analysis_70, freq_analysis_A,
+                                                       split_analysis, ev_realtime_enabled, insurance_analysis)
+                                  ? "enxuto (sem análises, log nem EV)"
+                                  : (nucleo_completo ? "completo (-full-kernel)" : "completo (análises, log ou EV ativos)"));
+    }
+    if (estrategia) {
+        printf("  Tabela de estratégia básica: %s (%016llx, %s)\n", estrategia_nome(estrategia),
+               (unsigned long long)estrategia_hash(estrategia),
+               estrategia_do_cache(estrategia) ? "lida do cache" : "compilada do texto");
+    }
+    if (arquivo_desvios) {
+        printf("  Desvios por true count: %s (%d regras)%s\n", arquivo_desvios, desvios_num_regras(),
+               desativar_desvios ? " - DESATIVADOS (-d)" : "");
+    }
     printf("  Linhas de log total: %d\n", log_level);
+    printf("  Semente RNG: %llu\n", (unsigned long long)semente_rng);
+    printf("  Embaralhamento: %s\n", lazy_shuffle ? "sob demanda (-lazy)" : (rng_simd_ativo() ? "completo (AVX2)" : "completo (escalar)"));
+    if (esquema_vr != VR_NENHUM) {
+        printf("  Redução de variância: %s\n", vr_nome(esquema_vr));
+    }
+    if (num_embaralhadoras > 0) {
+        printf("  Pipeline de shoes: %d embaralhadora(s), ring de %d shoes por worker\n", num_embaralhadoras, capacidade_ring);
+    }
+    if (arquivo_gravar_shoes) {
+        printf("  Gravando shoes em: %s\n", arquivo_gravar_shoes);
+    } else if (arquivo_reproduzir_shoes) {
+        printf("  Reproduzindo shoes de: %s (%llu shoes gravados)\n", arquivo_reproduzir_shoes,
+               (unsigned long long)shoe_corpus_header(shoe_corpus)->num_shoes);
+    }
     printf("  Debug: %s\n", debug_enabled ? "ATIVADO" : "DESATIVADO");
     printf("  Análise frequência 2-6: %s\n", freq_analysis_26 ? "ATIVADA" : "DESATIVADA");
     printf("  Análise frequência 7-10: %s\n", freq_analysis_70 ? "ATIVADA" : "DESATIVADA");
     printf("  Análise frequência A: %s\n", freq_analysis_A ? "ATIVADA" : "DESATIVADA");
     printf("  Análise de splits: %s\n", split_analysis ? "ATIVADA" : "DESATIVADA");
+    printf("  Análise de dealer BJ: %s\n", dealer_analysis ? "ATIVADA" : "DESATIVADA");
     printf("  Análise de insurance: %s\n", insurance_analysis ? "ATIVADA" : "DESATIVADA");
     if (output_suffix) {
         printf("  Sufixo de saída: %s\n", output_suffix);
@@ -1265,16 +1112,30 @@ int main(int argc, char* argv[]) {
     printf("\n");
     
     DEBUG_PRINT("Configuração de debug ativada");
-    DEBUG_STATS("Batch sizes: Dealer=%d, Freq=%d, Split=%d", DEALER_BATCH_SIZE, FREQ_BATCH_SIZE, SPLIT_BATCH_SIZE);
-    DEBUG_STATS("Buffers: Freq=%d (threshold=%d), Dealer=%d (threshold=%d)", 
-               FREQ_BUFFER_SIZE, FREQ_BUFFER_THRESHOLD, DEALER_BUFFER_SIZE, DEALER_BUFFER_THRESHOLD);
     
     // Sistema de estratégia básica super-otimizada
+    estrategia_flat_inicializar();
     printf("Sistema usando estratégia básica otimizada com tabelas inline.\n");
     
     // INICIALIZAR SISTEMA DE EV EM TEMPO REAL
     printf("🚀 Inicializando sistema de EV em tempo real...\n");
-    init_realtime_strategy_system(ev_realtime_enabled);
+    init_realtime_strategy_system(ev_realtime_enabled || (crn && crn_usa_ev(crn)));
+    
+    ReducaoVariancia reducao;
+    ReducaoVariancia* vr = NULL;
+    if (esquema_vr != VR_NENHUM) {
+        vr_set_esquema(esquema_vr);
+        if (vr_iniciar(&reducao, esquema_vr, num_threads) != 0) {
+            fprintf(stderr, "Erro ao alocar acumuladores de redução de variância\n");
+            return 1;
+        }
+        vr = &reducao;
+    }
+    
+    if (crn && crn_iniciar(crn, num_threads) != 0) {
+        fprintf(stderr, "Erro ao alocar acumuladores do modo pareado\n");
+        return 1;
+    }
     printf("\n");
     
     // Iniciar cronômetro
@@ -1312,15 +1173,42 @@ int main(int argc, char* argv[]) {
 
         thread_data[i].split_analysis = split_analysis;
         thread_data[i].ev_realtime_enabled = ev_realtime_enabled;
-        thread_data[i].dealer_mutex = dealer_analysis ? &dealer_mutex : NULL;
-        thread_data[i].freq_mutex = any_freq_analysis ? &freq_mutex : NULL;
-
-        thread_data[i].split_mutex = split_analysis ? &split_mutex : NULL;
         thread_data[i].insurance_analysis = insurance_analysis;
-        thread_data[i].insurance_mutex = insurance_analysis ? &insurance_mutex : NULL;
+        thread_data[i].rng_seed = semente_rng;
+        thread_data[i].lazy_shuffle = lazy_shuffle;
+        thread_data[i].shoe_ring = NULL;
+        thread_data[i].crn = crn;
+        thread_data[i].vr = vr;
         
         sim_offset = thread_data[i].sim_end;
-        
+    }
+    
+    // Pipeline opcional: embaralhadoras enchem um ring por worker
+    ShoePipeline* shoe_pipeline = NULL;
+    if (num_embaralhadoras > 0) {
+        int* sim_starts = malloc(num_threads * sizeof(int));
+        int* sim_ends = malloc(num_threads * sizeof(int));
+        if (!sim_starts || !sim_ends) {
+            fprintf(stderr, "Erro ao alocar memória para o pipeline de shoes\n");
+            return 1;
+        }
+        for (int i = 0; i < num_threads; ++i) {
+            sim_starts[i] = thread_data[i].sim_start;
+            sim_ends[i] = thread_data[i].sim_end;
+        }
+        shoe_pipeline = shoe_pipeline_criar(num_threads, sim_starts, sim_ends, num_embaralhadoras, (uint32_t)capacidade_ring, semente_rng);
+        free(sim_starts);
+        free(sim_ends);
+        if (!shoe_pipeline) {
+            fprintf(stderr, "Erro ao criar pipeline de shoes\n");
+            return 1;
+        }
+        for (int i = 0; i < num_threads; ++i) {
+            thread_data[i].shoe_ring = shoe_pipeline_ring(shoe_pipeline, i);
+        }
+    }
+    
+    for (int i = 0; i < num_threads; ++i) {
         if (pthread_create(&threads[i], NULL, worker_thread, &thread_data[i]) != 0) {
             fprintf(stderr, "Erro ao criar thread %d\n", i);
             return 1;
@@ -1341,28 +1229,40 @@ int main(int argc, char* argv[]) {
     show_progress(num_sims, num_sims, total_time);
     printf("\n\n");
     
+    if (shoe_pipeline) {
+        ShoePipelineStats stats;
+        shoe_pipeline_finalizar(shoe_pipeline, &stats);
+        // Tempo de CPU das embaralhadoras vs. espera de cada lado indica o gargalo:
+        // muitas esperas de ring vazio = embaralhadoras lentas; de ring cheio = workers lentos
+        printf("Pipeline de shoes:\n");
+        printf("  Embaralhadoras: %llu shoes, %.2f s embaralhando (%.0f shoes/s por thread), %llu esperas com ring cheio\n",
+               (unsigned long long)stats.shoes_produzidos, stats.segundos_embaralhando,
+               stats.segundos_embaralhando > 0 ? stats.shoes_produzidos / stats.segundos_embaralhando : 0.0,
+               (unsigned long long)stats.esperas_cheio);
+        printf("  Workers: %llu shoes consumidos (%.0f shoes/s), %llu esperas com ring vazio\n\n",
+               (unsigned long long)stats.shoes_consumidos,
+               total_time > 0 ? stats.shoes_consumidos / total_time : 0.0,
+               (unsigned long long)stats.esperas_vazio);
+    }
+    
     // Concatenar logs e limpar arquivos individuais se necessário
     if (log_level > 0) {
         printf("Concatenando arquivos de log...\n");
         concatenate_and_cleanup_logs(num_sims, output_suffix);
     }
     
-    // Processar dados de frequência se solicitado
-    if (freq_analysis_26 || freq_analysis_70 || freq_analysis_A) {
-        printf("Processando dados de análise de frequência...\n");
-        process_frequency_data(num_sims, output_suffix, freq_analysis_26, freq_analysis_70, freq_analysis_A);
-    }
-    
-    // Processar dados de split se solicitado
-    if (split_analysis) {
-        printf("Processando dados de análise de splits...\n");
-        process_split_data(num_sims, output_suffix);
-    }
-    
-    // Processar dados de insurance se solicitado
-    if (insurance_analysis) {
-        printf("Processando dados de análise de insurance...\n");
-        process_insurance_data(num_sims, output_suffix);
+    // Processar dados das análises solicitadas (frequência, splits, dealer BJ, insurance)
+    uint32_t analises = analises_ativas(freq_analysis_26, freq_analysis_70, freq_analysis_A,
+                                        split_analysis, dealer_analysis, insurance_analysis);
+    processar_analises(analises, output_suffix);
+    
+    // Contadores brutos para somar com outras execuções (merge)
+    if (arquivo_acumulador) {
+        AcumuladorHeader h = acumulador_header_atual(analises, (uint64_t)num_sims,
+                                                     estrategia ? estrategia_hash(estrategia) : 0, desvios_hash());
+        if (acumulador_gravar(arquivo_acumulador, &h) == 0) {
+            printf("Acumuladores salvos em: %s\n", arquivo_acumulador);
+        }
     }
     
     // Análise de bust obsoleta removida
@@ -1374,11 +1274,41 @@ int main(int argc, char* argv[]) {
     printf("  Jogos processados: %lld\n", (long long)num_sims * NUM_SHOES);
     printf("  Taxa de jogos: %.0f jogos/segundo\n", (num_sims * NUM_SHOES) / total_time);
     
+    // Reduzir as unidades das threads na ordem dos índices: o total não
+    // depende de qual thread terminou primeiro
+    UnidadesThread unidades = {0};
+    for (int i = 0; i < num_threads; i++) {
+        unidades_combinar(&unidades, &thread_data[i].unidades);
+    }
+    printf("  Taxa de rodadas: %.0f rodadas/segundo (%llu rodadas)\n", unidades.rodadas / total_time,
+           (unsigned long long)unidades.rodadas);
+    if (unidades.rodadas_anuladas > 0) {
+        printf("  Rodadas anuladas (shoe acabou no meio da rodada): %llu\n", (unsigned long long)unidades.rodadas_anuladas);
+    }
+    
     // Calcular e mostrar média de unidades por shoe
-    double unidades_totais = unidades_total_global;
+    double unidades_totais = soma_compensada_valor(&unidades.total);
     long long total_shoes = (long long)num_sims * NUM_SHOES;
     double unidade_media_por_shoe = unidades_totais / total_shoes;
-    printf("  Média de unidades por shoe: %.4f\n", unidade_media_por_shoe);
+    if (crn) {
+        // Total global soma todas as variantes; o relatório pareado separa cada uma
+        unidade_media_por_shoe /= crn->num_variantes;
+        printf("\n");
+        crn_imprimir_relatorio(crn);
+        crn_liberar(crn);
+    } else {
+        printf("  Média de unidades por shoe: %.4f\n", unidade_media_por_shoe);
+        imprimir_unidades(&unidades, thread_data, num_threads);
+    }
+    if (vr) {
+        printf("\n");
+        vr_imprimir_relatorio(vr);
+        vr_liberar(vr);
+    }
+    if (desvios_ativos()) {
+        printf("\n");
+        desvios_imprimir_relatorio();
+    }
     
     if (log_level > 0) {
         int final_log_count = atomic_load(&global_log_count);
@@ -1392,21 +1322,10 @@ int main(int argc, char* argv[]) {
     // Salvar análise de constantes
     salvar_analise_constantes(unidade_media_por_shoe);
     
-    // Destruir mutex se foi inicializado
-    if (dealer_analysis) {
-        pthread_mutex_destroy(&dealer_mutex);
-    }
-    if (any_freq_analysis) {
-        pthread_mutex_destroy(&freq_mutex);
-    }
-
-    if (split_analysis) {
-        pthread_mutex_destroy(&split_mutex);
-    }
-
-    if (insurance_analysis) {
-        pthread_mutex_destroy(&insurance_mutex);
-    }
+    shoe_corpus_set_ativo(NULL);
+    shoe_corpus_fechar(shoe_corpus);
+    estrategia_set_padrao(NULL);
+    estrategia_descarregar_todas();
     
     // FINALIZAR SISTEMA DE EV EM TEMPO REAL
     cleanup_realtime_strategy_system();
@@ -0,0 +1,79 @@
+#ifndef MAO_BITS_H
+#define MAO_BITS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Mão compactada em 52 bits: um campo de 4 bits por rank (índices 0..12 =
+// 2..A, campo do rank i nos bits 4i..4i+3) com a contagem de cartas daquele
+// rank. Adicionar uma carta é somar CARTA_POR_RANK[i] (= 1 << 4i). Cada campo
+// guarda até 15 cartas: em 8 baralhos só ases chegam a 12+ cartas numa mão
+// sem estourar.
+//
+// Os kernels abaixo trabalham em SWAR (vários campos por operação) em vez de
+// varrer os 13 campos: o total duro é um produto escalar contagem x peso
+// feito por multiplicação contra um vetor de pesos compactado, e ás/par são
+// testes de máscara.
+
+#define MAO_BITS_POR_RANK 4
+#define MAO_CAMPO         0xFULL
+#define MAO_MAX_POR_RANK  15
+
+#define MAO_CAMPO_AS      (MAO_CAMPO << 48)            // rank 12
+#define MAO_BIT1_CAMPOS   0x2222222222222ULL           // bit de valor 2 de cada campo
+
+// Campos separados em bytes: ranks pares (0,2,..,12) nos bytes 0..6 de um
+// registro e ímpares (1,3,..,11) nos bytes 0..5 de outro
+#define MAO_BYTES_PARES   0x000F0F0F0F0F0F0FULL
+#define MAO_BYTES_IMPARES 0x00000F0F0F0F0F0FULL
+
+// Pesos em ordem inversa (byte 6 - k = peso do k-ésimo campo): no produto,
+// o byte 6 recebe a soma contagem x peso. Valores duros: 2..9, 10 (T J Q K),
+// ás = 1.
+#define MAO_PESOS_PARES   0x020406080A0A01ULL          // 2 4 6 8 T Q A
+#define MAO_PESOS_IMPARES 0x030507090A0A00ULL          // 3 5 7 9 J K
+
+static inline uint64_t mao_bits_carta(int rank_idx) {
+    return 1ULL << (rank_idx * MAO_BITS_POR_RANK);
+}
+
+static inline int mao_bits_contagem(uint64_t bits, int rank_idx) {
+    return (int)((bits >> (rank_idx * MAO_BITS_POR_RANK)) & MAO_CAMPO);
+}
+
+// Total com ases valendo 1. Os bytes abaixo do 6 acumulam produtos cruzados
+// de no máximo 10 x nº de cartas, então não há vai-um até o byte 6 para mãos
+// de até 25 cartas (uma mão que ainda pode comprar tem total duro <= 21).
+static inline int mao_bits_total_duro(uint64_t bits) {
+    uint64_t pares = bits & MAO_BYTES_PARES;
+    uint64_t impares = (bits >> 4) & MAO_BYTES_IMPARES;
+    return (int)(((pares * MAO_PESOS_PARES + impares * MAO_PESOS_IMPARES) >> 48) & 0xFF);
+}
+
+static inline int mao_bits_num_cartas(uint64_t bits) {
+    uint64_t bytes = (bits & MAO_BYTES_PARES) + ((bits >> 4) & MAO_BYTES_IMPARES);
+    return (int)((bytes * 0x0101010101010101ULL) >> 56);
+}
+
+static inline bool mao_bits_tem_as(uint64_t bits) {
+    return (bits & MAO_CAMPO_AS) != 0;
+}
+
+// Soft: um ás pode valer 11 sem passar de 21
+static inline bool mao_bits_soft(uint64_t bits) {
+    return mao_bits_tem_as(bits) && mao_bits_total_duro(bits) <= 11;
+}
+
+static inline int mao_bits_valor(uint64_t bits) {
+    int total = mao_bits_total_duro(bits);
+    return (mao_bits_tem_as(bits) && total <= 11) ? total + 10 : total;
+}
+
+// Par: duas cartas do mesmo rank, ou seja, um único bit ligado e ele é o bit
+// de valor 2 de um campo. Retorna o índice do rank (0..12) ou -1.
+static inline int mao_bits_par_rank_idx(uint64_t bits) {
+    if (bits == 0 || (bits & (bits - 1)) != 0 || (bits & MAO_BIT1_CAMPOS) == 0) return -1;
+    return __builtin_ctzll(bits) / MAO_BITS_POR_RANK;
+}
+
+#endif // MAO_BITS_H
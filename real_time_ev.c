@@ -1,6 +1,7 @@
 #include "real_time_ev.h"
 #include "realtime_strategy_integration.h"  // Para acesso às estatísticas
 #include "jogo.h"
+#include "mao_bits.h"
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
@@ -61,58 +62,22 @@ double get_tc_bin_start(double true_count) {
 // ====================== ANÁLISE DE MÃOS ======================
 
 bool is_soft_hand(uint64_t hand_bits) {
-    // Verifica se há Ás e se pode ser contado como 11 sem bust
-    int aces = 0;
-    int total_value = 0;
-    int total_cards = 0;
-    
-    for (int idx = 0; idx < 13; ++idx) {
-        uint64_t count = (hand_bits >> (idx * 3)) & 0x7ULL;
-        if (count == 0) continue;
-        
-        total_cards += (int)count;
-        
-        if (idx <= 7) { // 2-9
-            total_value += (idx + 2) * count;
-        } else if (idx <= 11) { // 10,J,Q,K
-            total_value += 10 * count;
-        } else { // Ás
-            aces += (int)count;
-        }
-    }
-    
-    // Contar ases como 11 inicialmente
-    total_value += aces * 11;
-    
-    // Se pode contar pelo menos um ás como 11 sem bust, é soft
-    return (aces > 0 && total_value <= 21);
+    // Há Ás e todos podem ser contados como 11 sem bust (critério original
+    // deste módulo, mais estrito que mao_bits_soft para mãos com 2+ ases)
+    int aces = mao_bits_contagem(hand_bits, 12);
+    return aces > 0 && mao_bits_total_duro(hand_bits) + 10 * aces <= 21;
 }
 
 bool is_pair_hand(uint64_t hand_bits) {
-    int total_cards = 0;
-    int pairs_found = 0;
-    
-    for (int idx = 0; idx < 13; ++idx) {
-        uint64_t count = (hand_bits >> (idx * 3)) & 0x7ULL;
-        total_cards += (int)count;
-        if (count == 2) pairs_found++;
-    }
-    
-    return (total_cards == 2 && pairs_found == 1);
+    return mao_bits_par_rank_idx(hand_bits) >= 0;
 }
 
 int get_pair_rank(uint64_t hand_bits) {
-    if (!is_pair_hand(hand_bits)) return -1;
-    
-    for (int idx = 0; idx < 13; ++idx) {
-        uint64_t count = (hand_bits >> (idx * 3)) & 0x7ULL;
-        if (count == 2) {
-            if (idx <= 7) return idx + 2;  // 2-9
-            if (idx <= 11) return 10;      // 10,J,Q,K
-            return 11;                     // Ás
-        }
-    }
-    return -1;
+    int idx = mao_bits_par_rank_idx(hand_bits);
+    if (idx < 0) return -1;
+    if (idx <= 7) return idx + 2;  // 2-9
+    if (idx <= 11) return 10;      // 10,J,Q,K
+    return 11;                     // Ás
 }
 
 // ====================== PROBABILIDADES DO DEALER ======================
@@ -292,8 +257,8 @@ bool validate_shoe_counter(const ShoeCounter* counter) {
         return false;
     }
     
-    // Verificar se total é razoável (0-416 cartas para 8 decks)
-    if (counter->total_cards < 0 || counter->total_cards > 416) {
+    // Verificar se total é razoável (0 a 52 cartas por deck)
+    if (counter->total_cards < 0 || counter->total_cards > counter->original_decks * 52) {
         return false;
     }
     
@@ -483,11 +448,8 @@ uint64_t add_card_to_hand(uint64_t hand_bits, int card_rank) {
     if (rank_idx < 0) return hand_bits;
     
     // Adicionar uma carta do rank especificado
-    uint64_t mask = 7ULL << (rank_idx * 3); // Máscara para o rank
-    uint64_t current_count = (hand_bits & mask) >> (rank_idx * 3);
-    
-    if (current_count < 7) { // Máximo 7 cartas por rank
-        hand_bits += (1ULL << (rank_idx * 3));
+    if (mao_bits_contagem(hand_bits, rank_idx) < MAO_MAX_POR_RANK) {
+        hand_bits += mao_bits_carta(rank_idx);
     }
     
     return hand_bits;
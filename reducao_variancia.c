@@ -0,0 +1,324 @@
+#include "reducao_variancia.h"
+#include "constantes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define Z_95 1.959963984540054
+
+// Complemento de rank 2↔T, 3↔J, 4↔Q, 5↔K, 6↔A, 7↔9, 8↔8: troca cartas baixas
+// por altas, um mapa simétrico em Hi-Lo (os valores Hi-Lo trocam de sinal).
+// A contagem do simulador é Wong Halves, cujos pesos não são simétricos
+// (5 = +1.5 vira K = -1, 7 = +0.5 vira 9 = -0.5), então o running count do
+// shoe complementar não é o negativo do original; a correlação negativa vem
+// da troca de cartas baixas por altas, não de uma contagem negada.
+// É uma bijeção entre ranks com a mesma quantidade de cartas, então o shoe
+// complementar também é um embaralhamento uniforme.
+static const uint8_t RANK_COMPLEMENTO[13] = {8, 9, 10, 11, 12, 7, 6, 5, 0, 1, 2, 3, 4};
+
+// Cartas altas (T, J, Q, K, A) = índices de rank 8..12
+#define RANK_ALTO_MIN 8
+
+static EsquemaVR esquema_ativo = VR_NENHUM;
+
+// Estratificado: CDF hipergeométrica do nº de cartas altas na parte
+// distribuída do shoe (calculada uma vez em vr_set_esquema)
+static double *cdf_altas = NULL;
+static int max_altas = 0;
+static size_t cartas_distribuidas = 0;
+
+// Estado da simulação em andamento na thread
+static __thread int *permutacao_estratos = NULL;
+static __thread double *u_por_shoe = NULL;
+static __thread uint8_t *buffer_altas = NULL;
+static __thread uint8_t *buffer_baixas = NULL;
+
+int vr_parse(const char *nome, EsquemaVR *esquema) {
+    if (strcmp(nome, "antitetico-reverso") == 0) {
+        *esquema = VR_ANTITETICO_REVERSO;
+    } else if (strcmp(nome, "antitetico-complemento") == 0) {
+        *esquema = VR_ANTITETICO_COMPLEMENTO;
+    } else if (strcmp(nome, "estratificado") == 0) {
+        *esquema = VR_ESTRATIFICADO;
+    } else {
+        fprintf(stderr, "Erro: esquema '%s' inválido em -vr (use antitetico-reverso, antitetico-complemento ou estratificado)\n", nome);
+        return -1;
+    }
+    return 0;
+}
+
+const char* vr_nome(EsquemaVR esquema) {
+    switch (esquema) {
+        case VR_ANTITETICO_REVERSO:     return "antitético (ordem inversa)";
+        case VR_ANTITETICO_COMPLEMENTO: return "antitético (complemento baixas↔altas)";
+        case VR_ESTRATIFICADO:          return "estratificado (cartas altas na penetração)";
+        default:                        return "nenhum";
+    }
+}
+
+static double log_combinacoes(int n, int k) {
+    return lgamma(n + 1.0) - lgamma(k + 1.0) - lgamma(n - k + 1.0);
+}
+
+static void preparar_cdf_altas(void) {
+    int total = DECKS * 52;
+    int altas = DECKS * 4 * (13 - RANK_ALTO_MIN);
+    cartas_distribuidas = (size_t)(total * PENETRACAO);
+    int d = (int)cartas_distribuidas;
+    max_altas = d < altas ? d : altas;
+
+    free(cdf_altas);
+    cdf_altas = (double*)malloc(sizeof(double) * (size_t)(max_altas + 1));
+    if (!cdf_altas) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+
+    double acumulado = 0.0;
+    double log_total = log_combinacoes(total, d);
+    for (int h = 0; h <= max_altas; ++h) {
+        if (d - h <= total - altas) {
+            acumulado += exp(log_combinacoes(altas, h) + log_combinacoes(total - altas, d - h) - log_total);
+        }
+        cdf_altas[h] = acumulado;
+    }
+    cdf_altas[max_altas] = 1.0;
+}
+
+void vr_set_esquema(EsquemaVR esquema) {
+    esquema_ativo = esquema;
+    if (esquema == VR_ESTRATIFICADO) {
+        preparar_cdf_altas();
+    }
+}
+
+EsquemaVR vr_esquema(void) {
+    return esquema_ativo;
+}
+
+static double uniforme(RngState *rng) {
+    return (double)(rng_next_u64(rng) >> 11) * 0x1.0p-53;
+}
+
+static void embaralhar_trecho(uint8_t *cartas, size_t n, RngState *rng) {
+    for (size_t i = n; i > 1; --i) {
+        size_t j = rng_next_range(rng, (uint32_t)i);
+        uint8_t tmp = cartas[i - 1];
+        cartas[i - 1] = cartas[j];
+        cartas[j] = tmp;
+    }
+}
+
+static void *alocar_thread(void **buffer, size_t bytes) {
+    if (!*buffer) {
+        *buffer = malloc(bytes);
+        if (!*buffer) {
+            perror("malloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return *buffer;
+}
+
+// Estratos: a simulação distribui seus NUM_SHOES shoes entre NUM_SHOES
+// estratos equiprováveis de u ~ U(0,1) (um shoe por estrato, em ordem
+// aleatória). u escolhe, pela CDF inversa, quantas cartas altas caem na
+// parte distribuída; o shoe é então uniforme condicionado a esse número.
+static void preparar_shoe_estratificado(Shoe *shoe, RngState *rng, int shoe_idx) {
+    int *perm = (int*)alocar_thread((void**)&permutacao_estratos, sizeof(int) * (size_t)NUM_SHOES);
+    double *u_shoes = (double*)alocar_thread((void**)&u_por_shoe, sizeof(double) * (size_t)NUM_SHOES);
+    uint8_t *altas = (uint8_t*)alocar_thread((void**)&buffer_altas, shoe->total);
+    uint8_t *baixas = (uint8_t*)alocar_thread((void**)&buffer_baixas, shoe->total);
+
+    if (shoe_idx == 0) {
+        for (int i = 0; i < NUM_SHOES; ++i) perm[i] = i;
+        for (int i = NUM_SHOES - 1; i > 0; --i) {
+            int j = (int)rng_next_range(rng, (uint32_t)(i + 1));
+            int tmp = perm[i];
+            perm[i] = perm[j];
+            perm[j] = tmp;
+        }
+    }
+
+    double u = (perm[shoe_idx] + uniforme(rng)) / (double)NUM_SHOES;
+    u_shoes[shoe_idx] = u;
+
+    int h = 0;
+    while (h < max_altas && cdf_altas[h] <= u) ++h;
+
+    size_t n_altas = 0, n_baixas = 0;
+    for (size_t i = 0; i < shoe->total; ++i) {
+        uint8_t rank = shoe->cartas[i];
+        if (rank >= RANK_ALTO_MIN) altas[n_altas++] = rank;
+        else baixas[n_baixas++] = rank;
+    }
+    if (cartas_distribuidas - (size_t)h > n_baixas) h = (int)(cartas_distribuidas - n_baixas);
+    embaralhar_trecho(altas, n_altas, rng);
+    embaralhar_trecho(baixas, n_baixas, rng);
+
+    // Parte distribuída: h altas + (D - h) baixas; o restante vai para o fundo
+    size_t d = cartas_distribuidas;
+    size_t pos = 0;
+    memcpy(shoe->cartas + pos, altas, (size_t)h);                   pos += (size_t)h;
+    memcpy(shoe->cartas + pos, baixas, d - (size_t)h);              pos += d - (size_t)h;
+    memcpy(shoe->cartas + pos, altas + h, n_altas - (size_t)h);     pos += n_altas - (size_t)h;
+    memcpy(shoe->cartas + pos, baixas + (d - (size_t)h), n_baixas - (d - (size_t)h));
+
+    embaralhar_trecho(shoe->cartas, d, rng);
+    embaralhar_trecho(shoe->cartas + d, shoe->total - d, rng);
+    shoe->topo = 0;
+    shoe->rng_lazy = NULL;
+}
+
+void vr_preparar_shoe(Shoe *shoe, RngState *rng, int shoe_idx) {
+    switch (esquema_ativo) {
+        case VR_ANTITETICO_REVERSO:
+            // Shoe ímpar reaproveita o par anterior (ainda intacto no buffer)
+            if (shoe_idx & 1) {
+                for (size_t i = 0, j = shoe->total - 1; i < j; ++i, --j) {
+                    uint8_t tmp = shoe->cartas[i];
+                    shoe->cartas[i] = shoe->cartas[j];
+                    shoe->cartas[j] = tmp;
+                }
+                shoe->topo = 0;
+                shoe->rng_lazy = NULL;
+            } else {
+                baralho_embaralhar(shoe, rng);
+            }
+            break;
+        case VR_ANTITETICO_COMPLEMENTO:
+            if (shoe_idx & 1) {
+                for (size_t i = 0; i < shoe->total; ++i) {
+                    shoe->cartas[i] = RANK_COMPLEMENTO[shoe->cartas[i]];
+                }
+                shoe->topo = 0;
+                shoe->rng_lazy = NULL;
+            } else {
+                baralho_embaralhar(shoe, rng);
+            }
+            break;
+        case VR_ESTRATIFICADO:
+            preparar_shoe_estratificado(shoe, rng, shoe_idx);
+            break;
+        default:
+            baralho_embaralhar(shoe, rng);
+            break;
+    }
+}
+
+int vr_iniciar(ReducaoVariancia *vr, EsquemaVR esquema, int num_threads) {
+    vr->esquema = esquema;
+    vr->num_threads = num_threads;
+    vr->por_thread = (AcumuladorVR*)aligned_alloc(64, sizeof(AcumuladorVR) * (size_t)num_threads);
+    if (!vr->por_thread) return -1;
+    memset(vr->por_thread, 0, sizeof(AcumuladorVR) * (size_t)num_threads);
+
+    for (int t = 0; t < num_threads; ++t) {
+        vr->por_thread[t].unidades = (double*)calloc((size_t)NUM_SHOES, sizeof(double));
+        if (!vr->por_thread[t].unidades) return -1;
+    }
+    return 0;
+}
+
+void vr_liberar(ReducaoVariancia *vr) {
+    if (vr->por_thread) {
+        for (int t = 0; t < vr->num_threads; ++t) {
+            free(vr->por_thread[t].unidades);
+        }
+        free(vr->por_thread);
+        vr->por_thread = NULL;
+    }
+    free(cdf_altas);
+    cdf_altas = NULL;
+}
+
+double* vr_buffer_thread(ReducaoVariancia *vr, int thread_id) {
+    return vr->por_thread[thread_id].unidades;
+}
+
+// Chamada na thread que jogou a simulação (u_por_shoe é da thread)
+void vr_acumular_simulacao(ReducaoVariancia *vr, int thread_id) {
+    AcumuladorVR *acc = &vr->por_thread[thread_id];
+    for (int s = 0; s < NUM_SHOES; ++s) {
+        estatistica_adicionar(&acc->shoes, acc->unidades[s]);
+    }
+
+    if (vr->esquema == VR_ANTITETICO_REVERSO || vr->esquema == VR_ANTITETICO_COMPLEMENTO) {
+        for (int s = 0; s + 1 < NUM_SHOES; s += 2) {
+            estatistica_adicionar(&acc->pares, 0.5 * (acc->unidades[s] + acc->unidades[s + 1]));
+        }
+    } else if (vr->esquema == VR_ESTRATIFICADO) {
+        for (int s = 0; s < NUM_SHOES; ++s) {
+            int estrato = (int)(u_por_shoe[s] * VR_ESTRATOS);
+            if (estrato >= VR_ESTRATOS) estrato = VR_ESTRATOS - 1;
+            estatistica_adicionar(&acc->estratos[estrato], acc->unidades[s]);
+        }
+    }
+}
+
+void vr_liberar_thread(void) {
+    free(permutacao_estratos);
+    free(u_por_shoe);
+    free(buffer_altas);
+    free(buffer_baixas);
+    permutacao_estratos = NULL;
+    u_por_shoe = NULL;
+    buffer_altas = NULL;
+    buffer_baixas = NULL;
+}
+
+void vr_imprimir_relatorio(const ReducaoVariancia *vr) {
+    EstatisticaOnline shoes, pares;
+    EstatisticaOnline estratos[VR_ESTRATOS];
+    memset(&shoes, 0, sizeof(shoes));
+    memset(&pares, 0, sizeof(pares));
+    memset(estratos, 0, sizeof(estratos));
+
+    for (int t = 0; t < vr->num_threads; ++t) {
+        estatistica_combinar(&shoes, &vr->por_thread[t].shoes);
+        estatistica_combinar(&pares, &vr->por_thread[t].pares);
+        for (int e = 0; e < VR_ESTRATOS; ++e) {
+            estatistica_combinar(&estratos[e], &vr->por_thread[t].estratos[e]);
+        }
+    }
+    if (shoes.n == 0) return;
+
+    // Variância por shoe do Monte Carlo simples (os shoes têm marginal uniforme)
+    double var_simples = estatistica_variancia(&shoes);
+    double media = shoes.media;
+    double var_esquema = var_simples; // variância por shoe equivalente sob o esquema
+
+    if (vr->esquema == VR_ANTITETICO_REVERSO || vr->esquema == VR_ANTITETICO_COMPLEMENTO) {
+        // Cada par custa 2 shoes: var(média do par) * 2 = variância por shoe
+        if (pares.n > 1) {
+            media = pares.media;
+            var_esquema = 2.0 * estatistica_variancia(&pares);
+        }
+    } else if (vr->esquema == VR_ESTRATIFICADO) {
+        // Pós-estratificação em estratos equiprováveis de u (alocação proporcional)
+        double soma_media = 0.0, soma_var = 0.0;
+        int estratos_validos = 0;
+        for (int e = 0; e < VR_ESTRATOS; ++e) {
+            if (estratos[e].n > 1) {
+                soma_media += estratos[e].media;
+                soma_var += estatistica_variancia(&estratos[e]);
+                estratos_validos++;
+            }
+        }
+        if (estratos_validos == VR_ESTRATOS) {
+            media = soma_media / VR_ESTRATOS;
+            var_esquema = soma_var / VR_ESTRATOS;
+        }
+    }
+
+    double ep = sqrt(var_esquema / (double)shoes.n);
+    double ganho = (var_esquema > 0.0) ? var_simples / var_esquema : 0.0;
+
+    printf("Redução de variância: %s, %llu shoes\n", vr_nome(vr->esquema), (unsigned long long)shoes.n);
+    printf("  Média: %+.4f u/shoe  EP=%.4f  IC95%%=[%+.4f, %+.4f]\n",
+           media, ep, media - Z_95 * ep, media + Z_95 * ep);
+    printf("  DP por shoe: simples %.4f, sob o esquema %.4f\n", sqrt(var_simples), sqrt(var_esquema));
+    printf("  Ganho de amostra efetiva (ESS) vs Monte Carlo simples: %.2fx (%.0f shoes equivalentes)\n",
+           ganho, ganho * (double)shoes.n);
+}
@@ -0,0 +1,60 @@
+#ifndef REDUCAO_VARIANCIA_H
+#define REDUCAO_VARIANCIA_H
+
+#include "baralho.h"
+#include "rng.h"
+#include "estatistica_online.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Esquemas de redução de variância aplicados ao gerador de shoes.
+// Cada shoe continua com a distribuição marginal de um embaralhamento
+// uniforme; o que muda é a dependência entre os shoes de uma simulação.
+typedef enum {
+    VR_NENHUM = 0,
+    VR_ANTITETICO_REVERSO,      // shoe ímpar = shoe par em ordem inversa
+    VR_ANTITETICO_COMPLEMENTO,  // shoe ímpar = shoe par com baixas↔altas (mapa simétrico em Hi-Lo)
+    VR_ESTRATIFICADO            // estratos no nº de cartas altas da parte distribuída
+} EsquemaVR;
+
+// Estratos usados no relatório do esquema estratificado
+#define VR_ESTRATOS 20
+
+typedef struct {
+    EstatisticaOnline shoes;                 // unidades por shoe
+    EstatisticaOnline pares;                 // média de cada par antitético
+    EstatisticaOnline estratos[VR_ESTRATOS]; // unidades por shoe dentro de cada estrato
+    double *unidades;                        // buffer de uma simulação (NUM_SHOES)
+    char padding[64];
+} __attribute__((aligned(64))) AcumuladorVR;
+
+typedef struct {
+    EsquemaVR esquema;
+    AcumuladorVR *por_thread;
+    int num_threads;
+} ReducaoVariancia;
+
+// "antitetico-reverso" | "antitetico-complemento" | "estratificado"
+int vr_parse(const char *nome, EsquemaVR *esquema);
+const char* vr_nome(EsquemaVR esquema);
+
+int vr_iniciar(ReducaoVariancia *vr, EsquemaVR esquema, int num_threads);
+void vr_liberar(ReducaoVariancia *vr);
+
+// Esquema ativo do processo (definido em main antes de criar as threads)
+void vr_set_esquema(EsquemaVR esquema);
+EsquemaVR vr_esquema(void);
+
+// Gera o shoe shoe_idx da simulação segundo o esquema ativo
+void vr_preparar_shoe(Shoe *shoe, RngState *rng, int shoe_idx);
+
+// Buffer de unidades por shoe da thread e acumulação após cada simulação
+double* vr_buffer_thread(ReducaoVariancia *vr, int thread_id);
+void vr_acumular_simulacao(ReducaoVariancia *vr, int thread_id);
+// Libera os buffers da thread usados pelo esquema estratificado
+void vr_liberar_thread(void);
+
+// Imprime o ganho de tamanho efetivo de amostra (ESS) vs Monte Carlo simples
+void vr_imprimir_relatorio(const ReducaoVariancia *vr);
+
+#endif // REDUCAO_VARIANCIA_H
@@ -3,36 +3,205 @@
 #include <time.h>
 #include <unistd.h>
 #include <stdint.h>
+#include <string.h>
 
-// Estado interno do RNG (não pode ser zero)
-static uint64_t rng_state = 88172645463393265ULL;
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RNG_X86 1
+#else
+#define RNG_X86 0
+#endif
 
-// xorshift64* — rápido e com boa distribuição para a simulação
-static uint64_t xorshift64star(void) {
-    uint64_t x = rng_state;
-    x ^= x >> 12;
-    x ^= x << 25;
-    x ^= x >> 27;
-    rng_state = x;
-    return x * 2685821657736338717ULL;
+// splitmix64 — usado apenas para expandir sementes no estado do xoshiro
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
-void rng_init(void) {
+void rng_seed(RngState *rng, uint64_t seed, uint64_t stream) {
+    // Misturar o fluxo antes de combinar para que (seed, stream) vizinhos
+    // não produzam estados correlacionados
+    uint64_t mix = stream;
+    uint64_t x = seed ^ splitmix64(&mix);
+    for (int i = 0; i < 4; ++i) {
+        rng->s[i] = splitmix64(&x);
+    }
+    rng_simd_ativo(); // detecção do kernel fora do caminho de embaralhamento
+    // Estado todo zero é inválido para o xoshiro
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) {
+        rng->s[0] = 88172645463393265ULL;
+    }
+
+    // Lanes do gerador em bloco: cópias do fluxo escalar saltadas 1..RNG_LANES
+    // vezes, garantindo subsequências disjuntas entre si e do fluxo escalar
+    RngState tmp = *rng;
+    for (int l = 0; l < RNG_LANES; ++l) {
+        rng_jump(&tmp);
+        for (int k = 0; k < 4; ++k) {
+            rng->lanes[k][l] = tmp.s[k];
+        }
+    }
+}
+
+void rng_jump(RngState *rng) {
+    static const uint64_t JUMP[4] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if (JUMP[i] & (1ULL << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next_u64(rng);
+        }
+    }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+// =============== GERADOR EM BLOCO ===============
+
+// Avança os RNG_LANES lanes 'passos' vezes, gravando em out as saídas na ordem
+// lane 0..3 de cada passo. Referência escalar do kernel AVX2.
+static void lanes_bloco_escalar(uint64_t lanes[4][RNG_LANES], uint64_t *out, uint32_t passos) {
+    for (uint32_t p = 0; p < passos; ++p) {
+        for (int l = 0; l < RNG_LANES; ++l) {
+            uint64_t s0 = lanes[0][l], s1 = lanes[1][l], s2 = lanes[2][l], s3 = lanes[3][l];
+            out[p * RNG_LANES + l] = rng_rotl(s1 * 5, 7) * 9;
+            uint64_t t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = rng_rotl(s3, 45);
+            lanes[0][l] = s0; lanes[1][l] = s1; lanes[2][l] = s2; lanes[3][l] = s3;
+        }
+    }
+}
+
+#if RNG_X86
+// Mesmo algoritmo com os 4 lanes em um registrador AVX2.
+// Multiplicações por 5 e 9 viram shift+add (AVX2 não tem mul 64x64).
+__attribute__((target("avx2")))
+static void lanes_bloco_avx2(uint64_t lanes[4][RNG_LANES], uint64_t *out, uint32_t passos) {
+    __m256i s0 = _mm256_load_si256((const __m256i*)lanes[0]);
+    __m256i s1 = _mm256_load_si256((const __m256i*)lanes[1]);
+    __m256i s2 = _mm256_load_si256((const __m256i*)lanes[2]);
+    __m256i s3 = _mm256_load_si256((const __m256i*)lanes[3]);
+
+    for (uint32_t p = 0; p < passos; ++p) {
+        __m256i x5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+        __m256i r7 = _mm256_or_si256(_mm256_slli_epi64(x5, 7), _mm256_srli_epi64(x5, 57));
+        __m256i res = _mm256_add_epi64(_mm256_slli_epi64(r7, 3), r7);
+        _mm256_storeu_si256((__m256i*)(out + p * RNG_LANES), res);
+
+        __m256i t = _mm256_slli_epi64(s1, 17);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+    }
+
+    _mm256_store_si256((__m256i*)lanes[0], s0);
+    _mm256_store_si256((__m256i*)lanes[1], s1);
+    _mm256_store_si256((__m256i*)lanes[2], s2);
+    _mm256_store_si256((__m256i*)lanes[3], s3);
+}
+#endif
+
+// Kernel AVX2 disponível: detectado uma vez por thread (-1 = ainda não detectado)
+static __thread int simd_thread = -1;
+// rng_forcar_escalar: desliga o kernel AVX2 mesmo com suporte (testes)
+static int simd_desligado = 0;
+
+int rng_simd_ativo(void) {
+    if (simd_thread < 0) {
+#if RNG_X86
+        simd_thread = __builtin_cpu_supports("avx2") != 0;
+#else
+        simd_thread = 0;
+#endif
+    }
+    return simd_thread && !simd_desligado;
+}
+
+void rng_forcar_escalar(int forcar) {
+    simd_desligado = forcar != 0;
+}
+
+// Passos dos lanes por bloco: 64 x 4 palavras de 64 bits = 512 índices
+#define RNG_BLOCO_PASSOS 64
+
+void rng_fill_shuffle(RngState *rng, uint32_t *out, uint32_t n) {
+    if (n < 2) return;
+    uint32_t usados = n - 1;
+    const uint32_t palavras_bloco = RNG_BLOCO_PASSOS * RNG_LANES * 2;
+
+    // 1) Palavras brutas em blocos, num buffer uint64_t alinhado: os kernels
+    //    gravam palavras de 64 bits, que não podem ir direto em out (uint32_t)
+    // 2) Redução sem viés: a palavra k (metade baixa, depois alta, de cada
+    //    palavra de 64 bits) vira o índice do passo k
+    uint64_t bruto[RNG_BLOCO_PASSOS * RNG_LANES] __attribute__((aligned(32)));
+    int simd = rng_simd_ativo();
+    for (uint32_t inicio = 0; inicio < usados; inicio += palavras_bloco) {
+        uint32_t palavras = usados - inicio < palavras_bloco ? usados - inicio : palavras_bloco;
+        uint32_t passos = (palavras + 7) / 8;
+#if RNG_X86
+        if (simd) {
+            lanes_bloco_avx2(rng->lanes, bruto, passos);
+        } else {
+            lanes_bloco_escalar(rng->lanes, bruto, passos);
+        }
+#else
+        lanes_bloco_escalar(rng->lanes, bruto, passos);
+#endif
+        for (uint32_t i = 0; i < palavras; ++i) {
+            uint32_t x = (uint32_t)(bruto[i / 2] >> (32 * (i & 1)));
+            out[inicio + i] = rng_reduce(rng, x, n - (inicio + i));
+        }
+    }
+}
+
+uint64_t rng_seed_from_clock(void) {
     struct timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
     uint64_t seed = ((uint64_t)ts.tv_nsec) ^ ((uint64_t)ts.tv_sec << 21) ^ ((uint64_t)getpid() << 32) ^ (uint64_t)(uintptr_t)&ts;
-    if (seed == 0) seed = 88172645463393265ULL;
-    rng_state = seed;
-    // Descartar algumas saídas iniciais
-    for (int i = 0; i < 4; ++i) {
-        xorshift64star();
+    return seed ? seed : 88172645463393265ULL;
+}
+
+// Gerador padrão por thread para a API legada
+static __thread RngState thread_rng;
+static __thread int thread_rng_initialized = 0;
+
+void rng_init(void) {
+    rng_seed(&thread_rng, rng_seed_from_clock(), 0);
+    thread_rng_initialized = 1;
+}
+
+RngState *rng_thread_state(void) {
+    if (!thread_rng_initialized) {
+        rng_init();
     }
+    return &thread_rng;
 }
 
 uint32_t rng_u32(void) {
-    return (uint32_t)(xorshift64star() >> 32);
+    return rng_next_u32(rng_thread_state());
 }
 
 uint32_t rng_range(uint32_t max) {
-    return max ? (rng_u32() % max) : 0;
-} 
\ No newline at end of file
+    return rng_next_range(rng_thread_state(), max);
+}
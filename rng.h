@@ -3,8 +3,89 @@
 
 #include <stdint.h>
 
+// Número de lanes do gerador em bloco (4 x 64 bits = um registrador AVX2)
+#define RNG_LANES 4
+
+// Estado de um gerador xoshiro256** independente.
+// Cada thread/simulação mantém o seu próprio estado (sem compartilhamento
+// de cache line entre threads) e pode ser reproduzido a partir de (seed, stream).
+// Além do fluxo escalar, guarda RNG_LANES fluxos saltados (rng_jump) usados
+// para gerar blocos inteiros de números de uma vez.
+typedef struct {
+    uint64_t s[4];
+    uint64_t lanes[4][RNG_LANES] __attribute__((aligned(32))); // lanes[k][l] = palavra k do lane l
+} RngState;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// xoshiro256** — próxima saída de 64 bits
+static inline uint64_t rng_next_u64(RngState *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+static inline uint32_t rng_next_u32(RngState *rng) {
+    return (uint32_t)(rng_next_u64(rng) >> 32);
+}
+
+// Redução multiply-shift sem viés (Lemire): mapeia x uniforme em 32 bits para
+// [0, max). Só rejeita quando a parte baixa cai na faixa enviesada, caso em que
+// novas palavras são tiradas do fluxo escalar.
+static inline uint32_t rng_reduce(RngState *rng, uint32_t x, uint32_t max) {
+    uint64_t m = (uint64_t)x * max;
+    uint32_t l = (uint32_t)m;
+    if (l < max) {
+        uint32_t limite = (uint32_t)(-max) % max;
+        while (l < limite) {
+            m = (uint64_t)rng_next_u32(rng) * max;
+            l = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+static inline uint32_t rng_next_range(RngState *rng, uint32_t max) {
+    return max ? rng_reduce(rng, rng_next_u32(rng), max) : 0;
+}
+
+// Inicializa o estado a partir de uma semente global e de um identificador de
+// fluxo (ex.: sim_id). O mesmo par (seed, stream) gera sempre a mesma sequência.
+void rng_seed(RngState *rng, uint64_t seed, uint64_t stream);
+
+// Avança o estado escalar 2^128 passos (fluxos não sobrepostos a partir de uma semente)
+void rng_jump(RngState *rng);
+
+// Preenche out[k] (k = 0..n-2) com o índice do passo k de um Fisher-Yates
+// descendente: out[k] uniforme em [0, n-1-k]. Só out[0..n-2] é escrito;
+// RNG_SHUFFLE_CAPACITY(n) continua valendo como capacidade. Usa o kernel AVX2 quando a CPU suporta;
+// o fallback escalar produz exatamente a mesma sequência. rng.o é compilado
+// sem -march=native/-mavx2 (Makefile): só o kernel AVX2 usa target("avx2").
+#define RNG_SHUFFLE_CAPACITY(n) ((((n) + 7u) / 8u) * 8u)
+void rng_fill_shuffle(RngState *rng, uint32_t *out, uint32_t n);
+
+// Indica se o kernel AVX2 foi selecionado em tempo de execução (detecção
+// feita uma vez por thread)
+int rng_simd_ativo(void);
+// Força o fallback escalar mesmo com AVX2 (antes de criar as threads; testes)
+void rng_forcar_escalar(int forcar);
+
+// Semente derivada do relógio/pid, para execuções sem --seed
+uint64_t rng_seed_from_clock(void);
+
+// API legada: gerador padrão da thread atual (usado por testes e exemplos)
 void rng_init(void);
+RngState *rng_thread_state(void);
 uint32_t rng_u32(void);
 uint32_t rng_range(uint32_t max);
 
-#endif // RNG_H 
\ No newline at end of file
+#endif // RNG_H
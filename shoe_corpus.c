@@ -0,0 +1,202 @@
+#define _DEFAULT_SOURCE
+#include "shoe_corpus.h"
+#include "constantes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+struct ShoeCorpus {
+    ShoeCorpusModo modo;
+    ShoeCorpusHeader header;
+    size_t bytes_por_shoe;
+    int fd;
+    const uint8_t *mapa;        // reprodução: arquivo inteiro mapeado
+    size_t tamanho_mapa;
+};
+
+static ShoeCorpus *corpus_ativo = NULL;
+
+void shoe_corpus_set_ativo(ShoeCorpus *corpus) {
+    corpus_ativo = corpus;
+}
+
+ShoeCorpus* shoe_corpus_ativo(void) {
+    return corpus_ativo;
+}
+
+static size_t bytes_por_shoe(uint32_t cartas) {
+    return (cartas + 1) / 2;
+}
+
+ShoeCorpus* shoe_corpus_criar(const char *caminho, uint64_t semente, int num_sims) {
+    ShoeCorpus *corpus = (ShoeCorpus*)calloc(1, sizeof(ShoeCorpus));
+    if (!corpus) return NULL;
+
+    corpus->modo = CORPUS_GRAVACAO;
+    memcpy(corpus->header.magic, SHOE_CORPUS_MAGIC, sizeof(corpus->header.magic));
+    corpus->header.versao = SHOE_CORPUS_VERSAO;
+    corpus->header.decks = (uint32_t)DECKS;
+    corpus->header.cartas_por_shoe = (uint32_t)DECKS * 52;
+    corpus->header.shoes_por_sim = (uint32_t)NUM_SHOES;
+    corpus->header.semente = semente;
+    corpus->header.num_shoes = (uint64_t)num_sims * (uint64_t)NUM_SHOES;
+    corpus->bytes_por_shoe = bytes_por_shoe(corpus->header.cartas_por_shoe);
+
+    corpus->fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (corpus->fd < 0) {
+        fprintf(stderr, "Erro ao criar corpus de shoes %s: %s\n", caminho, strerror(errno));
+        free(corpus);
+        return NULL;
+    }
+
+    off_t tamanho = (off_t)sizeof(ShoeCorpusHeader) + (off_t)(corpus->header.num_shoes * corpus->bytes_por_shoe);
+    const ShoeCorpusHeader header = corpus->header;
+    if (pwrite(corpus->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        ftruncate(corpus->fd, tamanho) != 0) {
+        fprintf(stderr, "Erro ao preparar corpus de shoes %s: %s\n", caminho, strerror(errno));
+        close(corpus->fd);
+        free(corpus);
+        return NULL;
+    }
+    return corpus;
+}
+
+ShoeCorpus* shoe_corpus_abrir(const char *caminho) {
+    ShoeCorpus *corpus = (ShoeCorpus*)calloc(1, sizeof(ShoeCorpus));
+    if (!corpus) return NULL;
+    corpus->modo = CORPUS_REPRODUCAO;
+
+    corpus->fd = open(caminho, O_RDONLY);
+    if (corpus->fd < 0) {
+        fprintf(stderr, "Erro ao abrir corpus de shoes %s: %s\n", caminho, strerror(errno));
+        free(corpus);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(corpus->fd, &st) != 0 || (size_t)st.st_size < sizeof(ShoeCorpusHeader)) {
+        fprintf(stderr, "Corpus de shoes %s inválido (arquivo truncado)\n", caminho);
+        close(corpus->fd);
+        free(corpus);
+        return NULL;
+    }
+
+    corpus->tamanho_mapa = (size_t)st.st_size;
+    void *mapa = mmap(NULL, corpus->tamanho_mapa, PROT_READ, MAP_SHARED, corpus->fd, 0);
+    if (mapa == MAP_FAILED) {
+        fprintf(stderr, "Erro ao mapear corpus de shoes %s: %s\n", caminho, strerror(errno));
+        close(corpus->fd);
+        free(corpus);
+        return NULL;
+    }
+    corpus->mapa = (const uint8_t*)mapa;
+    memcpy(&corpus->header, corpus->mapa, sizeof(ShoeCorpusHeader));
+    corpus->bytes_por_shoe = bytes_por_shoe(corpus->header.cartas_por_shoe);
+
+    const ShoeCorpusHeader *h = &corpus->header;
+    const char *erro = NULL;
+    if (memcmp(h->magic, SHOE_CORPUS_MAGIC, sizeof(h->magic)) != 0) {
+        erro = "assinatura inválida";
+    } else if (h->versao != SHOE_CORPUS_VERSAO) {
+        erro = "versão não suportada";
+    } else if (h->decks != (uint32_t)DECKS || h->cartas_por_shoe != (uint32_t)DECKS * 52) {
+        erro = "número de decks diferente da build atual";
+    } else if (h->shoes_por_sim != (uint32_t)NUM_SHOES) {
+        erro = "shoes por simulação diferente da build atual";
+    } else if (corpus->tamanho_mapa < sizeof(ShoeCorpusHeader) + h->num_shoes * corpus->bytes_por_shoe) {
+        erro = "arquivo menor que o indicado no cabeçalho";
+    }
+    if (erro) {
+        fprintf(stderr, "Corpus de shoes %s inválido: %s\n", caminho, erro);
+        shoe_corpus_fechar(corpus);
+        return NULL;
+    }
+
+    madvise(mapa, corpus->tamanho_mapa, MADV_SEQUENTIAL);
+    return corpus;
+}
+
+void shoe_corpus_fechar(ShoeCorpus *corpus) {
+    if (!corpus) return;
+    if (corpus->mapa) {
+        munmap((void*)corpus->mapa, corpus->tamanho_mapa);
+    }
+    if (corpus->fd >= 0) {
+        close(corpus->fd);
+    }
+    free(corpus);
+}
+
+ShoeCorpusModo shoe_corpus_modo(const ShoeCorpus *corpus) {
+    return corpus->modo;
+}
+
+const ShoeCorpusHeader* shoe_corpus_header(const ShoeCorpus *corpus) {
+    return &corpus->header;
+}
+
+static uint64_t indice_shoe(const ShoeCorpus *corpus, int sim_id, int shoe_idx) {
+    uint64_t idx = (uint64_t)sim_id * corpus->header.shoes_por_sim + (uint64_t)shoe_idx;
+    if (idx >= corpus->header.num_shoes) {
+        fprintf(stderr, "Corpus de shoes não contém o shoe %d da simulação %d (%llu shoes no arquivo)\n",
+                shoe_idx, sim_id, (unsigned long long)corpus->header.num_shoes);
+        exit(EXIT_FAILURE);
+    }
+    return idx;
+}
+
+void shoe_corpus_gravar(ShoeCorpus *corpus, int sim_id, int shoe_idx, const Shoe *shoe) {
+    uint8_t buffer[512];
+    size_t n = corpus->bytes_por_shoe;
+    if (n > sizeof(buffer) || shoe->total != corpus->header.cartas_por_shoe) {
+        fprintf(stderr, "Shoe incompatível com o corpus (%zu cartas)\n", shoe->total);
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        uint8_t baixo = shoe->cartas[2 * i];
+        uint8_t alto = (2 * i + 1 < shoe->total) ? shoe->cartas[2 * i + 1] : 0;
+        buffer[i] = (uint8_t)(baixo | (alto << 4));
+    }
+
+    off_t offset = (off_t)sizeof(ShoeCorpusHeader) + (off_t)(indice_shoe(corpus, sim_id, shoe_idx) * n);
+    if (pwrite(corpus->fd, buffer, n, offset) != (ssize_t)n) {
+        fprintf(stderr, "Erro ao gravar shoe no corpus: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+}
+
+void shoe_corpus_ler(const ShoeCorpus *corpus, int sim_id, int shoe_idx, Shoe *shoe) {
+    const uint8_t *dados = corpus->mapa + sizeof(ShoeCorpusHeader) +
+                           indice_shoe(corpus, sim_id, shoe_idx) * corpus->bytes_por_shoe;
+    size_t total = corpus->header.cartas_por_shoe;
+    for (size_t i = 0; i + 1 < total; i += 2) {
+        uint8_t b = dados[i / 2];
+        shoe->cartas[i] = b & 0x0F;
+        shoe->cartas[i + 1] = b >> 4;
+    }
+    if (total & 1) {
+        shoe->cartas[total - 1] = dados[total / 2] & 0x0F;
+    }
+
+    // Cada rank aparece 4 vezes por baralho; um shoe nunca gravado (zeros =
+    // só "2") ou corrompido não passa e não é jogado em silêncio
+    uint32_t por_rank[16] = {0};
+    for (size_t i = 0; i < total; ++i) {
+        por_rank[shoe->cartas[i] & 0x0F]++;
+    }
+    for (int r = 0; r < 16; ++r) {
+        if (por_rank[r] != (r < 13 ? 4 * corpus->header.decks : 0)) {
+            fprintf(stderr, "Corpus de shoes: shoe %d da simulação %d não foi gravado ou está corrompido\n",
+                    shoe_idx, sim_id);
+            exit(EXIT_FAILURE);
+        }
+    }
+    shoe->topo = 0;
+    shoe->rng_lazy = NULL;
+}
@@ -0,0 +1,54 @@
+#ifndef SHOE_CORPUS_H
+#define SHOE_CORPUS_H
+
+#include "baralho.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Corpus de shoes gravados: cabeçalho fixo seguido dos shoes em ordem
+// (sim_id * shoes_por_sim + shoe_idx), cada um com as cartas empacotadas
+// em 4 bits por rank (carta par no nibble baixo). Permite rodar duas builds
+// sobre exatamente as mesmas distribuições, ou medir o motor de jogo sem o
+// custo do embaralhamento.
+
+#define SHOE_CORPUS_MAGIC "BJSHOE01"
+#define SHOE_CORPUS_VERSAO 1
+
+typedef struct {
+    char magic[8];
+    uint32_t versao;
+    uint32_t decks;
+    uint32_t cartas_por_shoe;
+    uint32_t shoes_por_sim;
+    uint64_t semente;           // semente RNG usada na gravação
+    uint64_t num_shoes;         // total de shoes no arquivo
+    uint8_t reservado[24];      // cabeçalho com 64 bytes
+} ShoeCorpusHeader;
+
+_Static_assert(sizeof(ShoeCorpusHeader) == 64, "cabeçalho do corpus deve ter 64 bytes");
+
+typedef enum {
+    CORPUS_GRAVACAO,
+    CORPUS_REPRODUCAO
+} ShoeCorpusModo;
+
+typedef struct ShoeCorpus ShoeCorpus;
+
+// Gravação: cria o arquivo já no tamanho final; cada shoe é escrito com
+// pwrite na sua posição, sem lock entre threads
+ShoeCorpus* shoe_corpus_criar(const char *caminho, uint64_t semente, int num_sims);
+// Reprodução: mapeia o arquivo (mmap) e valida o cabeçalho
+ShoeCorpus* shoe_corpus_abrir(const char *caminho);
+void shoe_corpus_fechar(ShoeCorpus *corpus);
+
+ShoeCorpusModo shoe_corpus_modo(const ShoeCorpus *corpus);
+const ShoeCorpusHeader* shoe_corpus_header(const ShoeCorpus *corpus);
+
+void shoe_corpus_gravar(ShoeCorpus *corpus, int sim_id, int shoe_idx, const Shoe *shoe);
+void shoe_corpus_ler(const ShoeCorpus *corpus, int sim_id, int shoe_idx, Shoe *shoe);
+
+// Corpus ativo do processo (definido em main antes de criar as threads)
+void shoe_corpus_set_ativo(ShoeCorpus *corpus);
+ShoeCorpus* shoe_corpus_ativo(void);
+
+#endif // SHOE_CORPUS_H
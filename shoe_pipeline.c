@@ -0,0 +1,271 @@
+#define _POSIX_C_SOURCE 199309L
+#include "shoe_pipeline.h"
+#include "constantes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+
+// Estado de produção de um ring: reproduz exatamente a sequência de
+// embaralhamentos que o worker faria em simulacao_completa
+typedef struct {
+    ShoeRing *ring;
+    Shoe shoe;                  // shoe de trabalho (ordem evolui shoe a shoe)
+    RngState rng;
+    int sim_id;
+    int shoe_idx;
+} ProducaoRing;
+
+typedef struct {
+    ShoePipeline *pipeline;
+    int primeiro_ring;          // rings primeiro_ring, +passo, +2*passo...
+    int passo;
+    pthread_t thread;
+
+    // Contadores da embaralhadora (só ela escreve)
+    uint64_t produzidos __attribute__((aligned(64)));
+    uint64_t esperas_cheio;
+    double segundos_embaralhando;
+} Embaralhadora;
+
+struct ShoePipeline {
+    ShoeRing *rings;
+    int num_rings;
+    Embaralhadora *embaralhadoras;
+    int num_embaralhadoras;
+    uint64_t semente;
+};
+
+static __thread ShoeRing *ring_thread = NULL;
+
+void shoe_pipeline_set_ring(ShoeRing *ring) {
+    ring_thread = ring;
+}
+
+ShoeRing* shoe_pipeline_ring_thread(void) {
+    return ring_thread;
+}
+
+static double agora_segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void producao_iniciar_sim(ProducaoRing *p, uint64_t semente) {
+    // Mesma inicialização de simulacao_completa: shoe canônico + fluxo (semente, sim_id)
+    baralho_reiniciar(&p->shoe);
+    rng_seed(&p->rng, semente, (uint64_t)p->sim_id);
+    p->shoe_idx = 0;
+}
+
+static bool producao_terminou(const ProducaoRing *p) {
+    return p->sim_id >= p->ring->sim_end;
+}
+
+// Tenta publicar um shoe no ring. Retorna false se o ring estiver cheio.
+static bool producao_publicar(ProducaoRing *p, Embaralhadora *e, uint64_t semente) {
+    ShoeRing *ring = p->ring;
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail >= ring->capacidade) {
+        return false;
+    }
+
+    double t0 = agora_segundos();
+    baralho_embaralhar(&p->shoe, &p->rng);
+    uint32_t slot = (uint32_t)(head & (ring->capacidade - 1));
+    memcpy(ring->cartas + (size_t)slot * ring->cartas_por_shoe, p->shoe.cartas, ring->cartas_por_shoe);
+    ring->tag_sim[slot] = p->sim_id;
+    ring->tag_shoe[slot] = p->shoe_idx;
+    e->segundos_embaralhando += agora_segundos() - t0;
+
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    e->produzidos++;
+
+    if (++p->shoe_idx >= NUM_SHOES) {
+        p->sim_id++;
+        if (!producao_terminou(p)) {
+            producao_iniciar_sim(p, semente);
+        }
+    }
+    return true;
+}
+
+static void* embaralhadora_thread(void *arg) {
+    Embaralhadora *e = (Embaralhadora*)arg;
+    ShoePipeline *pipeline = e->pipeline;
+
+    int num_producoes = 0;
+    for (int r = e->primeiro_ring; r < pipeline->num_rings; r += e->passo) {
+        num_producoes++;
+    }
+    // aligned_alloc: RngState exige alinhamento de 32 bytes (lanes AVX2)
+    size_t bytes = sizeof(ProducaoRing) * (size_t)(num_producoes > 0 ? num_producoes : 1);
+    ProducaoRing *producoes = (ProducaoRing*)aligned_alloc(_Alignof(ProducaoRing), bytes);
+    if (!producoes) {
+        fprintf(stderr, "Erro ao alocar estado da embaralhadora\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(producoes, 0, bytes);
+
+    int n = 0;
+    for (int r = e->primeiro_ring; r < pipeline->num_rings; r += e->passo) {
+        ProducaoRing *p = &producoes[n++];
+        p->ring = &pipeline->rings[r];
+        baralho_criar(&p->shoe);
+        p->sim_id = p->ring->sim_start;
+        if (!producao_terminou(p)) {
+            producao_iniciar_sim(p, pipeline->semente);
+        }
+    }
+
+    // Round-robin entre os rings atendidos: um shoe por ring por volta,
+    // para que nenhum worker fique sem shoes enquanto outro enche o ring
+    int ativos = num_producoes;
+    while (ativos > 0) {
+        bool progresso = false;
+        ativos = 0;
+        for (int i = 0; i < num_producoes; ++i) {
+            ProducaoRing *p = &producoes[i];
+            if (producao_terminou(p)) continue;
+            ativos++;
+            if (producao_publicar(p, e, pipeline->semente)) {
+                progresso = true;
+            }
+        }
+        if (ativos > 0 && !progresso) {
+            e->esperas_cheio++;
+            sched_yield();
+        }
+    }
+
+    for (int i = 0; i < num_producoes; ++i) {
+        baralho_destruir(&producoes[i].shoe);
+    }
+    free(producoes);
+    baralho_liberar_thread();
+    return NULL;
+}
+
+ShoePipeline* shoe_pipeline_criar(int num_workers, const int *sim_start, const int *sim_end,
+                                  int num_embaralhadoras, uint32_t capacidade, uint64_t semente) {
+    if (num_workers <= 0 || num_embaralhadoras <= 0 || capacidade == 0) {
+        return NULL;
+    }
+    // Capacidade arredondada para potência de 2 (índice por máscara)
+    uint32_t cap = 1;
+    while (cap < capacidade) cap <<= 1;
+
+    ShoePipeline *pipeline = (ShoePipeline*)calloc(1, sizeof(ShoePipeline));
+    if (!pipeline) return NULL;
+    pipeline->num_rings = num_workers;
+    pipeline->num_embaralhadoras = num_embaralhadoras;
+    pipeline->semente = semente;
+    pipeline->rings = (ShoeRing*)aligned_alloc(64, sizeof(ShoeRing) * (size_t)num_workers);
+    pipeline->embaralhadoras = (Embaralhadora*)aligned_alloc(64, sizeof(Embaralhadora) * (size_t)num_embaralhadoras);
+    if (!pipeline->rings || !pipeline->embaralhadoras) {
+        fprintf(stderr, "Erro ao alocar pipeline de shoes\n");
+        exit(EXIT_FAILURE);
+    }
+
+    uint32_t cartas_por_shoe = (uint32_t)DECKS * 52;
+    for (int w = 0; w < num_workers; ++w) {
+        ShoeRing *ring = &pipeline->rings[w];
+        memset(ring, 0, sizeof(*ring));
+        ring->capacidade = cap;
+        ring->cartas_por_shoe = cartas_por_shoe;
+        ring->sim_start = sim_start[w];
+        ring->sim_end = sim_end[w];
+        ring->cartas = (uint8_t*)malloc((size_t)cap * cartas_por_shoe);
+        ring->tag_sim = (int*)malloc(sizeof(int) * cap);
+        ring->tag_shoe = (int*)malloc(sizeof(int) * cap);
+        if (!ring->cartas || !ring->tag_sim || !ring->tag_shoe) {
+            fprintf(stderr, "Erro ao alocar ring de shoes\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->tail, 0);
+    }
+
+    for (int i = 0; i < num_embaralhadoras; ++i) {
+        Embaralhadora *e = &pipeline->embaralhadoras[i];
+        memset(e, 0, sizeof(*e));
+        e->pipeline = pipeline;
+        e->primeiro_ring = i;
+        e->passo = num_embaralhadoras;
+        if (pthread_create(&e->thread, NULL, embaralhadora_thread, e) != 0) {
+            fprintf(stderr, "Erro ao criar thread embaralhadora %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    return pipeline;
+}
+
+ShoeRing* shoe_pipeline_ring(ShoePipeline *pipeline, int worker_id) {
+    return &pipeline->rings[worker_id];
+}
+
+// Espera o próximo slot pronto e confere a marca (sim_id, shoe_idx)
+static uint32_t esperar_slot(ShoeRing *ring, uint64_t tail, int sim_id, int shoe_idx) {
+    if (atomic_load_explicit(&ring->head, memory_order_acquire) == tail) {
+        ring->esperas_vazio++;
+        while (atomic_load_explicit(&ring->head, memory_order_acquire) == tail) {
+            sched_yield();
+        }
+    }
+
+    uint32_t slot = (uint32_t)(tail & (ring->capacidade - 1));
+    if (ring->tag_sim[slot] != sim_id || ring->tag_shoe[slot] != shoe_idx) {
+        fprintf(stderr, "Pipeline de shoes dessincronizado: esperado (%d,%d), recebido (%d,%d)\n",
+                sim_id, shoe_idx, ring->tag_sim[slot], ring->tag_shoe[slot]);
+        exit(EXIT_FAILURE);
+    }
+    return slot;
+}
+
+void shoe_pipeline_pop(ShoeRing *ring, int sim_id, int shoe_idx, Shoe *shoe) {
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t slot = esperar_slot(ring, tail, sim_id, shoe_idx);
+    memcpy(shoe->cartas, ring->cartas + (size_t)slot * ring->cartas_por_shoe, ring->cartas_por_shoe);
+    shoe->topo = 0;
+    shoe->rng_lazy = NULL;
+
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    ring->consumidos++;
+}
+
+void shoe_pipeline_descartar(ShoeRing *ring, int sim_id, int shoe_idx) {
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    esperar_slot(ring, tail, sim_id, shoe_idx);
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+void shoe_pipeline_finalizar(ShoePipeline *pipeline, ShoePipelineStats *stats) {
+    if (!pipeline) return;
+    if (stats) memset(stats, 0, sizeof(*stats));
+
+    for (int i = 0; i < pipeline->num_embaralhadoras; ++i) {
+        Embaralhadora *e = &pipeline->embaralhadoras[i];
+        pthread_join(e->thread, NULL);
+        if (stats) {
+            stats->shoes_produzidos += e->produzidos;
+            stats->esperas_cheio += e->esperas_cheio;
+            stats->segundos_embaralhando += e->segundos_embaralhando;
+        }
+    }
+    for (int w = 0; w < pipeline->num_rings; ++w) {
+        ShoeRing *ring = &pipeline->rings[w];
+        if (stats) {
+            stats->shoes_consumidos += ring->consumidos;
+            stats->esperas_vazio += ring->esperas_vazio;
+        }
+        free(ring->cartas);
+        free(ring->tag_sim);
+        free(ring->tag_shoe);
+    }
+    free(pipeline->rings);
+    free(pipeline->embaralhadoras);
+    free(pipeline);
+}
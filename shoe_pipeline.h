@@ -0,0 +1,64 @@
+#ifndef SHOE_PIPELINE_H
+#define SHOE_PIPELINE_H
+
+#include "baralho.h"
+#include "rng.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+// Pipeline de embaralhamento antecipado: threads embaralhadoras preenchem um
+// ring SPSC por worker com shoes prontos. Cada slot é marcado com
+// (sim_id, shoe_idx) e os shoes são idênticos aos que o worker geraria
+// sozinho com a mesma semente, então os resultados não mudam.
+
+// Ring de um worker: um único produtor (embaralhadora) e um único consumidor
+typedef struct {
+    uint8_t *cartas;            // capacidade * cartas_por_shoe bytes
+    int *tag_sim;               // sim_id de cada slot
+    int *tag_shoe;              // índice do shoe na simulação de cada slot
+    uint32_t capacidade;        // potência de 2
+    uint32_t cartas_por_shoe;
+
+    // Simulações do worker dono do ring [sim_start, sim_end)
+    int sim_start;
+    int sim_end;
+
+    _Atomic uint64_t head __attribute__((aligned(64)));  // escrito pelo produtor
+    _Atomic uint64_t tail __attribute__((aligned(64)));  // escrito pelo consumidor
+
+    // Contadores do consumidor (só o worker escreve)
+    uint64_t consumidos __attribute__((aligned(64)));
+    uint64_t esperas_vazio;     // pops que encontraram o ring vazio
+} ShoeRing;
+
+typedef struct ShoePipeline ShoePipeline;
+
+// Estatísticas agregadas por estágio
+typedef struct {
+    uint64_t shoes_produzidos;
+    uint64_t esperas_cheio;     // back-pressure: embaralhadora sem slot livre
+    double segundos_embaralhando;
+    uint64_t shoes_consumidos;
+    uint64_t esperas_vazio;     // workers esperando shoe pronto
+} ShoePipelineStats;
+
+// Cria os rings e dispara num_embaralhadoras threads. sim_start/sim_end
+// descrevem as simulações de cada um dos num_workers workers.
+ShoePipeline* shoe_pipeline_criar(int num_workers, const int *sim_start, const int *sim_end,
+                                  int num_embaralhadoras, uint32_t capacidade, uint64_t semente);
+ShoeRing* shoe_pipeline_ring(ShoePipeline *pipeline, int worker_id);
+void shoe_pipeline_finalizar(ShoePipeline *pipeline, ShoePipelineStats *stats);
+
+// Ring do worker atual (thread-local); NULL = sem pipeline, worker embaralha
+void shoe_pipeline_set_ring(ShoeRing *ring);
+ShoeRing* shoe_pipeline_ring_thread(void);
+
+// Copia o próximo shoe pronto para 'shoe', conferindo a marca (sim_id, shoe_idx)
+void shoe_pipeline_pop(ShoeRing *ring, int sim_id, int shoe_idx, Shoe *shoe);
+// Retira sem copiar um shoe que a simulação não vai jogar (simulação
+// encerrada antes pelo limite de -l); mantém o ring alinhado com as embaralhadoras
+void shoe_pipeline_descartar(ShoeRing *ring, int sim_id, int shoe_idx);
+
+#endif // SHOE_PIPELINE_H
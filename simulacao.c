@@ -6,7 +6,11 @@
 #include "saidas.h"
 #include "tabela_estrategia.h"
 #include "structures.h"  // Usar estruturas centralizadas
-#include "shoe_counter.h"  // Para ShoeCounter
+#include "contador_cartas.h" // ShoeCounter, running e true count por carta
+#include "shoe_pipeline.h"  // Shoes pré-embaralhados (opcional)
+#include "shoe_corpus.h"    // Gravação/reprodução de shoes
+#include "reducao_variancia.h" // Shoes antitéticos/estratificados (-vr)
+#include "liquidacao.h"     // Liquidação vetorizada das mãos da rodada
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -15,92 +19,326 @@
 #include <errno.h>
 #include <stdatomic.h>
 
-// Declarações das funções binárias do main.c
-void write_dealer_binary(FILE* file, double true_count, int ace_upcard, int dealer_bj);
+static void adicionar_carta(uint64_t *mao, Carta c) {
+    *mao += c; // incrementa o contador de 4 bits para o rank
+}
 
-void write_split_binary(FILE* file, double true_count, int lose_lose, int win_win, int push_push, int lose_win, 
-                       int lose_push, int win_lose, int win_push, int push_lose, int push_win, int cards_used);
-void write_freq_binary(FILE* file, double true_count);
+// Função identificar_split_10_tipo removida - não utilizada no sistema atual
 
-// Sufixo para arquivos binários
-#define BINARY_SUFFIX ".bin"
+// Memory pool para evitar malloc/free frequentes
+#define MAX_MAOS_PER_ROUND 100  // Máximo de mãos por rodada
+static __thread uint64_t maos_bits_pool[MAX_MAOS_PER_ROUND];
 
-// Estrutura para buffer local de dados de frequência por thread
-typedef struct {
-    double true_count;
-    int upcard;
-    int final_result;
-} FreqBufferEntry;
+// Arena das mãos jogadas na rodada, indexada por id de mão: cada assento
+// acrescenta sua mão e as de split em sequência e todas são jogadas e
+// liquidadas no lugar, sem cópia. Os dados frios (histórico e metadados de
+// split) ficam em arena paralela, usada só com log ou análise de splits.
+#define MAX_MAOS_ARENA 128      // 10 assentos com folga para resplits
+static __thread Mao arena_maos[MAX_MAOS_ARENA + 1];      // +1: vaga de descarte
+static __thread MaoFria arena_frias[MAX_MAOS_ARENA + 1];
 
-// Estrutura para buffer de dados de dealer
-typedef struct {
-    double true_count;
-    int ace_upcard;
-    int dealer_bj;
-} DealerBufferEntry;
+// Colunas da liquidação em lote (liquidacao.h), na ordem da arena
+static __thread int32_t liq_valor[MAX_MAOS_ARENA] __attribute__((aligned(32)));
+static __thread uint32_t liq_flags[MAX_MAOS_ARENA] __attribute__((aligned(32)));
+static __thread double liq_aposta[MAX_MAOS_ARENA] __attribute__((aligned(32)));
+static __thread int32_t liq_resultado[MAX_MAOS_ARENA] __attribute__((aligned(32)));
+static __thread double liq_pnl[MAX_MAOS_ARENA] __attribute__((aligned(32)));
+
+// Histogramas da análise de frequência do dealer (-hist26/-hist70/-histA):
+// contadores da thread por [upcard][bin de TC] e [upcard][final][bin de TC],
+// somados nos totais globais uma vez ao fim de cada worker
+static __thread uint64_t freq_total_thread[FREQ_UPCARDS][MAX_BINS];
+static __thread uint64_t freq_final_thread[FREQ_UPCARDS][FREQ_FINAIS][MAX_BINS];
+static _Atomic uint64_t freq_total_global[FREQ_UPCARDS][MAX_BINS];
+static _Atomic uint64_t freq_final_global[FREQ_UPCARDS][FREQ_FINAIS][MAX_BINS];
+
+void simulacao_freq_acumular_thread(void) {
+    for (int u = 0; u < FREQ_UPCARDS; ++u) {
+        for (int b = 0; b < MAX_BINS; ++b) {
+            if (freq_total_thread[u][b]) {
+                atomic_fetch_add(&freq_total_global[u][b], freq_total_thread[u][b]);
+                freq_total_thread[u][b] = 0;
+            }
+            for (int f = 0; f < FREQ_FINAIS; ++f) {
+                if (freq_final_thread[u][f][b]) {
+                    atomic_fetch_add(&freq_final_global[u][f][b], freq_final_thread[u][f][b]);
+                    freq_final_thread[u][f][b] = 0;
+                }
+            }
+        }
+    }
+}
+
+uint64_t simulacao_freq_total(int upcard_idx, int bin) {
+    return atomic_load(&freq_total_global[upcard_idx][bin]);
+}
 
-// Buffer para insurance (similar ao dealer buffer)
-#define INSURANCE_BUFFER_THRESHOLD 1000
+uint64_t simulacao_freq_final(int upcard_idx, int final_idx, int bin) {
+    return atomic_load(&freq_final_global[upcard_idx][final_idx][bin]);
+}
 
+// Registra o resultado final do dealer (0-4: 17..21, 5: BJ, 6: BUST, -1: nenhum)
+// no bin de TC capturado antes da hole card; bin -1 = TC fora de [MIN_TC, MAX_TC)
+static inline void freq_registrar(int dealer_up_rank, int final_result, int tc_bin) {
+    if (tc_bin < 0) return;
+    int upcard_idx = (dealer_up_rank == 11) ? 9 : dealer_up_rank - 2;
+    freq_total_thread[upcard_idx][tc_bin]++;
+    if (final_result >= 0) freq_final_thread[upcard_idx][final_result][tc_bin]++;
+}
+
+// Acumuladores da análise de splits (-split) por [par][upcard][bin de TC],
+// alocados na primeira mão de split da thread e somados nos totais globais
+// ao fim de cada worker
+static __thread SplitBin *split_thread = NULL;
+static _Atomic uint64_t split_global[SPLIT_PARES][SPLIT_UPCARDS][MAX_BINS][SPLIT_COMBINACOES + 3];
+
+// Combinação (mão 1, mão 2) na ordem das colunas do CSV; resultado 0 = D, 1 = V, 2 = E
+static const int8_t SPLIT_COMBINACAO[3][3] = {
+    {0, 3, 4},   // D/D, D/V, D/E
+    {5, 1, 6},   // V/D, V/V, V/E
+    {7, 8, 2},   // E/D, E/V, E/E
+};
+
+static inline int split_resultado_idx(char resultado) {
+    return resultado == 'D' ? 0 : resultado == 'V' ? 1 : resultado == 'E' ? 2 : -1;
+}
+
+static void split_registrar(int pair_index, int upcard_index, int tc_bin, char resultado1, char resultado2, int cartas_usadas) {
+    int r1 = split_resultado_idx(resultado1);
+    int r2 = split_resultado_idx(resultado2);
+    if (r1 < 0 || r2 < 0 || tc_bin < 0) return;
+    if (!split_thread) {
+        split_thread = (SplitBin*)calloc((size_t)SPLIT_PARES * SPLIT_UPCARDS * MAX_BINS, sizeof(SplitBin));
+        if (!split_thread) {
+            perror("calloc split_thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    SplitBin *b = &split_thread[((size_t)pair_index * SPLIT_UPCARDS + upcard_index) * MAX_BINS + tc_bin];
+    b->splits++;
+    b->combinacoes[SPLIT_COMBINACAO[r1][r2]]++;
+    b->cartas += (uint64_t)cartas_usadas;
+    b->cartas_quadrado += (uint64_t)(cartas_usadas * cartas_usadas);
+}
+
+void simulacao_split_acumular_thread(void) {
+    if (!split_thread) return;
+    for (int p = 0; p < SPLIT_PARES; ++p) {
+        for (int u = 0; u < SPLIT_UPCARDS; ++u) {
+            for (int i = 0; i < MAX_BINS; ++i) {
+                const SplitBin *b = &split_thread[((size_t)p * SPLIT_UPCARDS + u) * MAX_BINS + i];
+                if (!b->splits) continue;
+                _Atomic uint64_t *g = split_global[p][u][i];
+                atomic_fetch_add(&g[0], b->splits);
+                for (int c = 0; c < SPLIT_COMBINACOES; ++c) {
+                    atomic_fetch_add(&g[1 + c], b->combinacoes[c]);
+                }
+                atomic_fetch_add(&g[SPLIT_COMBINACOES + 1], b->cartas);
+                atomic_fetch_add(&g[SPLIT_COMBINACOES + 2], b->cartas_quadrado);
+            }
+        }
+    }
+    free(split_thread);
+    split_thread = NULL;
+}
+
+void simulacao_split_bin(int pair_index, int upcard_index, int bin, SplitBin *out) {
+    _Atomic uint64_t *g = split_global[pair_index][upcard_index][bin];
+    out->splits = atomic_load(&g[0]);
+    for (int c = 0; c < SPLIT_COMBINACOES; ++c) {
+        out->combinacoes[c] = atomic_load(&g[1 + c]);
+    }
+    out->cartas = atomic_load(&g[SPLIT_COMBINACOES + 1]);
+    out->cartas_quadrado = atomic_load(&g[SPLIT_COMBINACOES + 2]);
+}
+
+// Análises com upcard Ás, contadas na decisão de insurance (antes da hole
+// card): blackjack do dealer por bin de TC (-dealer) e por bin de densidade de
+// cartas de valor 10 no shoe (-ins). Contadores da thread somados nos totais
+// globais uma vez ao fim de cada worker
+static __thread AsBin dealer_bj_thread[MAX_BINS];
+static __thread AsBin insurance_thread[INSURANCE_BINS];
+static _Atomic uint64_t dealer_bj_global[MAX_BINS][2];
+static _Atomic uint64_t insurance_global[INSURANCE_BINS][2];
+
+static void as_acumular(AsBin *locais, _Atomic uint64_t (*globais)[2], int num_bins) {
+    for (int i = 0; i < num_bins; ++i) {
+        if (!locais[i].ases) continue;
+        atomic_fetch_add(&globais[i][0], locais[i].ases);
+        atomic_fetch_add(&globais[i][1], locais[i].blackjacks);
+        locais[i].ases = 0;
+        locais[i].blackjacks = 0;
+    }
+}
+
+void simulacao_as_acumular_thread(void) {
+    as_acumular(dealer_bj_thread, dealer_bj_global, MAX_BINS);
+    as_acumular(insurance_thread, insurance_global, INSURANCE_BINS);
+}
+
+AsBin simulacao_dealer_bj_bin(int tc_bin) {
+    AsBin b = { atomic_load(&dealer_bj_global[tc_bin][0]), atomic_load(&dealer_bj_global[tc_bin][1]) };
+    return b;
+}
+
+AsBin simulacao_insurance_bin(int bin) {
+    AsBin b = { atomic_load(&insurance_global[bin][0]), atomic_load(&insurance_global[bin][1]) };
+    return b;
+}
+
+// Bin de densidade de cartas de valor 10 (0,1% cada a partir de 30%) em
+// aritmética inteira; -1 fora de [30%, 40,1%)
+static inline int insurance_bin(int cartas_dez, int cartas_restantes) {
+    if (cartas_restantes <= 0) return -1;
+    int numerador = 1000 * cartas_dez - INSURANCE_MIN_PERMIL * cartas_restantes;
+    if (numerador < 0) return -1;
+    int bin = numerador / cartas_restantes;
+    return bin < INSURANCE_BINS ? bin : -1;
+}
+
+// Totais de todas as análises em ordem fixa (layout do arquivo de
+// acumuladores, acumulador_arquivo.h)
 typedef struct {
-    float ten_cards_percentage;
-    int dealer_blackjack;
-} InsuranceBufferEntry;
+    _Atomic uint64_t *inicio;
+    size_t num_contadores;
+} SecaoTotais;
+
+#define SECAO_TOTAIS(a) { (_Atomic uint64_t*)(a), sizeof(a) / sizeof(_Atomic uint64_t) }
+
+static const SecaoTotais secoes_totais[] = {
+    SECAO_TOTAIS(freq_total_global),
+    SECAO_TOTAIS(freq_final_global),
+    SECAO_TOTAIS(split_global),
+    SECAO_TOTAIS(dealer_bj_global),
+    SECAO_TOTAIS(insurance_global),
+};
 
-static InsuranceBufferEntry insurance_buffer[INSURANCE_BUFFER_THRESHOLD];
-static int insurance_buffer_count = 0;
-static int current_sim_id = 0;
+#define NUM_SECOES_TOTAIS (sizeof(secoes_totais) / sizeof(secoes_totais[0]))
 
-static void set_insurance_sim_id(int sim_id) {
-    current_sim_id = sim_id;
+size_t simulacao_totais_num_contadores(void) {
+    size_t n = 0;
+    for (size_t s = 0; s < NUM_SECOES_TOTAIS; ++s) {
+        n += secoes_totais[s].num_contadores;
+    }
+    return n;
 }
 
-static void flush_insurance_buffer() {
-    if (insurance_buffer_count == 0) return;
-    
-    // Calcular qual lote esta simulação pertence
-    int batch_id = current_sim_id / 20000;
-    char insurance_filepath[512];
-    snprintf(insurance_filepath, sizeof(insurance_filepath), "%s%d%s", INSURANCE_TEMP_FILE_PREFIX, batch_id, BINARY_SUFFIX);
-    
-    FILE* insurance_file = fopen(insurance_filepath, "ab");
-    if (insurance_file) {
-        for (int i = 0; i < insurance_buffer_count; i++) {
-            InsuranceBinaryRecord record;
-            record.ten_cards_percentage = insurance_buffer[i].ten_cards_percentage;
-            record.dealer_blackjack = insurance_buffer[i].dealer_blackjack;
-            record.checksum = calculate_insurance_checksum(&record);
-            fwrite(&record, sizeof(record), 1, insurance_file);
+void simulacao_totais_exportar(uint64_t *destino) {
+    for (size_t s = 0; s < NUM_SECOES_TOTAIS; ++s) {
+        for (size_t i = 0; i < secoes_totais[s].num_contadores; ++i) {
+            *destino++ = atomic_load(&secoes_totais[s].inicio[i]);
         }
-        fclose(insurance_file);
     }
-    
-    insurance_buffer_count = 0;
 }
 
-static void adicionar_carta(uint64_t *mao, Carta c) {
-    *mao += c; // incrementa o contador de 3 bits para o rank
+void simulacao_totais_somar(const uint64_t *origem) {
+    for (size_t s = 0; s < NUM_SECOES_TOTAIS; ++s) {
+        for (size_t i = 0; i < secoes_totais[s].num_contadores; ++i, ++origem) {
+            if (*origem) atomic_fetch_add(&secoes_totais[s].inicio[i], *origem);
+        }
+    }
 }
 
-static void atualizar_counts(double *running_count, double *true_count, Carta c, size_t cartas_restantes) {
-    *running_count += WONG_HALVES[carta_para_rank_idx(c)];
-    double decks_restantes = (double)cartas_restantes / 52.0;
-    if (decks_restantes < 1.0) decks_restantes = 1.0;
-    *true_count = *running_count / decks_restantes;
-    
-    DEBUG_STATS("Counts atualizados: carta=%d, RC=%.3f, TC=%.3f, cartas_restantes=%zu", 
-               carta_para_rank_idx(c), *running_count, *true_count, cartas_restantes);
+// Unidades das simulações da thread; cada simulação soma suas rodadas numa
+// soma compensada local e registra o total aqui ao terminar
+static __thread UnidadesThread unidades_thread;
+
+static void unidades_registrar_sim(double unidades_sim, uint64_t rodadas, uint64_t rodadas_anuladas) {
+    UnidadesThread *u = &unidades_thread;
+    u->rodadas += rodadas;
+    u->rodadas_anuladas += rodadas_anuladas;
+    if (u->por_sim.n == 0 || unidades_sim < u->minimo_sim) u->minimo_sim = unidades_sim;
+    if (u->por_sim.n == 0 || unidades_sim > u->maximo_sim) u->maximo_sim = unidades_sim;
+    soma_compensada_adicionar(&u->total, unidades_sim);
+    estatistica_adicionar(&u->por_sim, unidades_sim);
 }
 
-// Função identificar_split_10_tipo removida - não utilizada no sistema atual
+void unidades_combinar(UnidadesThread *destino, const UnidadesThread *origem) {
+    if (origem->por_sim.n == 0) return;
+    if (destino->por_sim.n == 0 || origem->minimo_sim < destino->minimo_sim) destino->minimo_sim = origem->minimo_sim;
+    if (destino->por_sim.n == 0 || origem->maximo_sim > destino->maximo_sim) destino->maximo_sim = origem->maximo_sim;
+    destino->rodadas += origem->rodadas;
+    destino->rodadas_anuladas += origem->rodadas_anuladas;
+    soma_compensada_combinar(&destino->total, &origem->total);
+    estatistica_combinar(&destino->por_sim, &origem->por_sim);
+}
 
-void simulacao_completa(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, pthread_mutex_t* dealer_mutex, pthread_mutex_t* freq_mutex, pthread_mutex_t* split_mutex, bool insurance_analysis, pthread_mutex_t* insurance_mutex) {
-    // Configurar sim_id para insurance buffer
-    set_insurance_sim_id(sim_id);
+void simulacao_unidades_coletar_thread(UnidadesThread *destino) {
+    *destino = unidades_thread;
+    memset(&unidades_thread, 0, sizeof(unidades_thread));
+}
+
+// Variante da thread (modo pareado): rampa de apostas e saída por shoe
+static __thread const RampaApostas *rampa_thread = NULL;
+static __thread double *unidades_por_shoe_thread = NULL;
+
+void simulacao_set_variante(const RampaApostas *rampa, double *unidades_por_shoe) {
+    rampa_thread = rampa;
+    unidades_por_shoe_thread = unidades_por_shoe;
+}
+
+// Rodada em que o shoe acabou antes do fim: não conta e libera as mãos
+static void anular_rodada(uint64_t *rodadas, uint64_t *rodadas_anuladas, uint64_t *maos_bits, int total_maos) {
+    (*rodadas)--;
+    (*rodadas_anuladas)++;
+    if (total_maos > MAX_MAOS_PER_ROUND) {
+        free(maos_bits);
+    }
+}
+
+// Prepara o próximo shoe da simulação a partir da fonte configurada:
+// corpus gravado, pipeline de embaralhadoras, esquema de redução de
+// variância ou embaralhamento local
+static void preparar_shoe(Shoe *shoe, RngState *rng, int sim_id, int shoe_idx, ShoeRing *shoe_ring, bool lazy_shuffle) {
+    ShoeCorpus *corpus = shoe_corpus_ativo();
+    if (corpus && shoe_corpus_modo(corpus) == CORPUS_REPRODUCAO) {
+        shoe_corpus_ler(corpus, sim_id, shoe_idx, shoe);
+        return;
+    }
+
+    if (shoe_ring) {
+        shoe_pipeline_pop(shoe_ring, sim_id, shoe_idx, shoe);
+    } else if (lazy_shuffle) {
+        baralho_embaralhar_lazy(shoe, rng);
+    } else if (vr_esquema() != VR_NENHUM) {
+        vr_preparar_shoe(shoe, rng, shoe_idx);
+    } else {
+        baralho_embaralhar(shoe, rng);
+    }
+
+    if (corpus) {
+        shoe_corpus_gravar(corpus, sim_id, shoe_idx, shoe);
+    }
+}
+
+// Recursos opcionais do laço de rodadas (máscara constante de cada instância)
+#define REC_LOG       (1u << 0)
+#define REC_FREQ      (1u << 1)
+#define REC_SPLIT     (1u << 2)
+#define REC_DEALER    (1u << 3)
+#define REC_INSURANCE (1u << 4)
+#define REC_EV        (1u << 5)
+#define REC_TODOS     (REC_LOG | REC_FREQ | REC_SPLIT | REC_DEALER | REC_INSURANCE | REC_EV)
+
+// Corpo da simulação. Sempre expandido nas instâncias abaixo: com decks e
+// num_jogadores constantes, limites de laço e divisores são dobrados pelo
+// compilador como na época em que eram constantes de compilação; com a
+// máscara de recursos constante, o mesmo vale para as flags de análise.
+static inline __attribute__((always_inline)) void simulacao_kernel(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis, uint64_t rng_seed_base, bool lazy_shuffle, const int decks, const int num_jogadores, const unsigned recursos) {
     DEBUG_PRINT("Iniciando simulação %d", sim_id);
+
+    // Recursos fora da máscara são falsos em tempo de compilação: no núcleo
+    // enxuto (recursos == 0) os testes por rodada e por mão desaparecem
+    if (!(recursos & REC_LOG)) log_level = 0;
+    dealer_analysis = (recursos & REC_DEALER) && dealer_analysis;
+    freq_analysis_26 = (recursos & REC_FREQ) && freq_analysis_26;
+    freq_analysis_70 = (recursos & REC_FREQ) && freq_analysis_70;
+    freq_analysis_A = (recursos & REC_FREQ) && freq_analysis_A;
+    split_analysis = (recursos & REC_SPLIT) && split_analysis;
+    ev_realtime_enabled = (recursos & REC_EV) && ev_realtime_enabled;
+    insurance_analysis = (recursos & REC_INSURANCE) && insurance_analysis;
     
     FILE *log_file = NULL;
-    FILE *dealer_file = NULL;
     
     // Inicializar logging apenas se log_level > 0
     if (log_level > 0) {
@@ -132,162 +370,12 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
         DEBUG_IO("Arquivo de log criado: %s", filepath);
     }
     
-    // Inicializar arquivo de dealer se análise está ativada
-    if (dealer_analysis) {
-        // Calcular qual lote esta simulação pertence (CORRIGIDO: usar DEALER_BATCH_SIZE)
-        int batch_id = sim_id / DEALER_BATCH_SIZE;  
-        char dealer_filepath[512];
-        snprintf(dealer_filepath, sizeof(dealer_filepath), "%s%d%s", DEALER_TEMP_FILE_PREFIX, batch_id, BINARY_SUFFIX);
-        
-        DEBUG_IO("Criando arquivo dealer para sim %d, batch %d: %s", sim_id, batch_id, dealer_filepath);
-        
-        dealer_file = fopen(dealer_filepath, "ab");  // Modo append binário para múltiplas simulações
-        if (!dealer_file) {
-            perror("fopen dealer_file");
-            if (log_file) fclose(log_file);
-            return;
-        }
-        // Arquivos binários não precisam de cabeçalho
-    }
-    
-    // Inicializar arquivos de frequência se análise está ativada
-    FILE* freq_total_files[11]; // Para contar total de cada upcard
-    FILE* freq_result_files[11][7]; // [upcard][final_value] - para contar resultados específicos (0-6: 17,18,19,20,21,BJ,BUST)
-    memset(freq_total_files, 0, sizeof(freq_total_files));
-    memset(freq_result_files, 0, sizeof(freq_result_files));
-    
-    // Inicializar arquivos de split se análise está ativada
-    FILE* split_files[10][10]; // [pair][upcard] - 10 pares x 10 upcards (removidos JJ, QQ, KK)
-    memset(split_files, 0, sizeof(split_files));
-    
     bool any_freq_analysis = freq_analysis_26 || freq_analysis_70 || freq_analysis_A;
-    if (any_freq_analysis) {
-        // Calcular qual lote esta simulação pertence (CORRIGIDO: usar FREQ_BATCH_SIZE)
-        int batch_id = sim_id / FREQ_BATCH_SIZE;  
-        
-        DEBUG_PRINT("Configurando análise de frequência para sim %d, batch %d", sim_id, batch_id);
-        
-        // Determinar quais upcards precisam ser analisados
-        int start_upcard = 11, end_upcard = 1; // Valores inválidos = nenhum upcard por padrão
-        bool include_ace = false;
-        
-        if (freq_analysis_26 && freq_analysis_70) {
-            // Ambos ativos: 2-6 e 7-10 = 2-10
-            start_upcard = 2; end_upcard = 10;
-            DEBUG_PRINT("Analisando upcards 2-10 (freq_analysis_26 + freq_analysis_70)");
-        } else if (freq_analysis_26) {
-            // Apenas 2-6
-            start_upcard = 2; end_upcard = 6;
-            DEBUG_PRINT("Analisando upcards 2-6");
-        } else if (freq_analysis_70) {
-            // Apenas 7-10
-            start_upcard = 7; end_upcard = 10;
-            DEBUG_PRINT("Analisando upcards 7-10");
-        }
-        
-        if (freq_analysis_A) {
-            include_ace = true;
-            DEBUG_PRINT("Analisando upcard A");
-        }
-        
-        // Criar arquivos de total para cada upcard
-        for (int upcard = start_upcard; upcard <= end_upcard; upcard++) {
-            char total_filepath[512];
-            snprintf(total_filepath, sizeof(total_filepath), "temp_total_upcard_%d_batch_%d%s", upcard, batch_id, BINARY_SUFFIX);
-            
-            freq_total_files[upcard-2] = fopen(total_filepath, "ab");
-            if (!freq_total_files[upcard-2]) {
-                perror("fopen freq_total_file");
-                continue;
-            }
-            DEBUG_IO("Arquivo freq total criado: %s", total_filepath);
-            // Arquivos binários não precisam de cabeçalho
-        }
-        
-        // Criar arquivos de resultado para cada combinação upcard/final
-        for (int upcard = start_upcard; upcard <= end_upcard; upcard++) {
-            for (int final_val = 0; final_val < 7; final_val++) {
-                // Criar arquivo BJ apenas para upcards que podem ter blackjack (10 e A não se aplicam aqui pois start_upcard <= 10)
-                if (final_val == 5 && upcard != 10) {  // BJ apenas para upcard 10
-                    continue; // Pular criação de arquivo BJ para upcards 2-9
-                }
-                
-                char result_filepath[512];
-                const char* final_names[] = {"17", "18", "19", "20", "21", "BJ", "BUST"};
-                snprintf(result_filepath, sizeof(result_filepath), "temp_result_upcard_%d_final_%s_batch_%d%s", upcard, final_names[final_val], batch_id, BINARY_SUFFIX);
-                
-                freq_result_files[upcard-2][final_val] = fopen(result_filepath, "ab");
-                if (!freq_result_files[upcard-2][final_val]) {
-                    perror("fopen freq_result_file");
-                    continue;
-                }
-                DEBUG_IO("Arquivo freq result criado: %s", result_filepath);
-                // Arquivos binários não precisam de cabeçalho
-            }
-        }
-        
-        // Criar arquivos para upcard A se necessário
-        if (include_ace) {
-            char total_filepath[512];
-            snprintf(total_filepath, sizeof(total_filepath), "temp_total_upcard_A_batch_%d%s", batch_id, BINARY_SUFFIX);
-            
-            freq_total_files[9] = fopen(total_filepath, "ab"); // Índice 9 para Ás
-            if (!freq_total_files[9]) {
-                perror("fopen freq_total_file A");
-            } else {
-                DEBUG_IO("Arquivo freq total A criado: %s", total_filepath);
-            }
-            // Arquivos binários não precisam de cabeçalho
-            
-            for (int final_val = 0; final_val < 7; final_val++) {
-                // Upcard A pode ter blackjack, então criamos todos os arquivos incluindo BJ e BUST
-                char result_filepath[512];
-                const char* final_names[] = {"17", "18", "19", "20", "21", "BJ", "BUST"};
-                snprintf(result_filepath, sizeof(result_filepath), "temp_result_upcard_A_final_%s_batch_%d%s", final_names[final_val], batch_id, BINARY_SUFFIX);
-                
-                freq_result_files[9][final_val] = fopen(result_filepath, "ab");
-                if (!freq_result_files[9][final_val]) {
-                    perror("fopen freq_result_file A");
-                    continue;
-                }
-                DEBUG_IO("Arquivo freq result A criado: %s", result_filepath);
-                // Arquivos binários não precisam de cabeçalho
-            }
-        }
-    }
-    
-    // Inicializar arquivos de split se análise está ativada
-    if (split_analysis) {
-        // Calcular qual lote esta simulação pertence (CORRIGIDO: usar SPLIT_BATCH_SIZE)
-        int batch_id = sim_id / SPLIT_BATCH_SIZE;  
-        
-        DEBUG_PRINT("Configurando análise de split para sim %d, batch %d", sim_id, batch_id);
-        
-        // Pares a analisar (10 pares rank-descendente): AA, 1010, 99, 88, 77, 66, 55, 44, 33, 22
-        // Removidos JJ, QQ, KK conforme solicitado
-        const char* pairs[] = {"AA", "1010", "99", "88", "77", "66", "55", "44", "33", "22"};
-        
-        // Upcards do dealer (10 possibilidades): 2-10, A
-        const char* upcards[] = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "A"};
-        
-        // Criar arquivos para cada combinação de par e upcard
-        for (int p = 0; p < 10; p++) {
-            for (int u = 0; u < 10; u++) {
-                char split_filepath[512];
-                snprintf(split_filepath, sizeof(split_filepath), "%s%d_%s_vs_%s%s", SPLIT_TEMP_FILE_PREFIX, batch_id, pairs[p], upcards[u], BINARY_SUFFIX);
-                
-                split_files[p][u] = fopen(split_filepath, "ab");
-                if (!split_files[p][u]) {
-                    perror("fopen split_file");
-                    continue;
-                }
-                DEBUG_IO("Arquivo split criado: %s", split_filepath);
-                // Arquivos binários não precisam de cabeçalho
-            }
-        }
-    }
     
-    rng_init();
+    // Gerador local desta simulação: (semente, sim_id) define todos os shoes,
+    // de modo que qualquer simulação pode ser reproduzida bit a bit
+    RngState rng;
+    rng_seed(&rng, rng_seed_base, (uint64_t)sim_id);
     
     // Variáveis para controle do bankroll e estatísticas
     double bankroll = BANKROLL_INICIAL;
@@ -296,158 +384,41 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
     double pnl_shoe = 0.0;      // PNL acumulado do shoe atual
     double loss_shoe = 0.0;     // Unidades perdidas no shoe atual
     double unidade_atual = UNIDADE_INICIAL;
+    double unidades_shoe = 0.0; // Resultado do shoe atual em unidades (modo pareado)
+    SomaCompensada unidades_sim = {0.0, 0.0}; // Resultado da simulação em unidades
+    uint64_t rodadas = 0;       // Rodadas jogadas na simulação
+    uint64_t rodadas_anuladas = 0; // Rodadas em que o shoe acabou (não contam)
     
     int shoes_jogados = 0;
-    double running_count = 0.0;
-    double true_count = 0.0;
+    ContadorCartas contador;   // Cartas vistas no shoe atual: ShoeCounter, RC e TC
     
-    // Memory pool para evitar malloc/free frequentes
-    #define MAX_MAOS_PER_ROUND 100  // Máximo de mãos por rodada
-    static __thread uint64_t maos_bits_pool[MAX_MAOS_PER_ROUND];
-    static __thread bool pool_initialized = false;
-    if (!pool_initialized) {
-        memset(maos_bits_pool, 0, sizeof(maos_bits_pool));
-        pool_initialized = true;
-    }
-
-    // Buffers locais para análise (por thread) - todos os tipos de análise
-    static __thread FreqBufferEntry freq_buffer[FREQ_BUFFER_SIZE];
-    static __thread int freq_buffer_count = 0;
-    static __thread DealerBufferEntry dealer_buffer[DEALER_BUFFER_SIZE];
-    static __thread int dealer_buffer_count = 0;
-
-    // Função otimizada para flush do buffer de frequência - escreve tudo em lotes grandes
-    void flush_freq_buffer() {
-        if (freq_buffer_count == 0) return;
-        
-        DEBUG_MUTEX("Tentando obter mutex de frequência para flush");
-        
-        // Obter lock apenas uma vez para todo o buffer
-        if (freq_mutex) {
-            pthread_mutex_lock(freq_mutex);
-            DEBUG_MUTEX("Mutex de frequência obtido, flushing %d registros", freq_buffer_count);
-            
-            // Agrupar entries por arquivo para reduzir operações de I/O
-            int batch_id = sim_id / FREQ_BATCH_SIZE;  // CORRIGIDO: usar FREQ_BATCH_SIZE
-            
-            // Arrays para agrupar dados por arquivo
-            FreqBinaryRecord* records_by_file[11][7]; // [upcard][final_result]
-            int counts_by_file[11][7];
-            memset(counts_by_file, 0, sizeof(counts_by_file));
-            
-            // Alocar buffers para cada arquivo
-            for (int u = 0; u < 11; u++) {
-                for (int f = 0; f < 7; f++) {
-                    records_by_file[u][f] = malloc(freq_buffer_count * sizeof(FreqBinaryRecord));
-                    if (!records_by_file[u][f]) {
-                        DEBUG_IO("ERRO: Falha ao alocar buffer para upcard %d, final %d", u, f);
-                    }
-                }
-            }
-            
-            // Agrupar todos os entries por arquivo
-            for (int i = 0; i < freq_buffer_count; i++) {
-                FreqBufferEntry* entry = &freq_buffer[i];
-                
-                int upcard_idx = (entry->upcard == 11) ? 9 : entry->upcard - 2;
-                if (upcard_idx >= 0 && upcard_idx < 11 && entry->final_result >= 0 && entry->final_result < 7) {
-                    int count = counts_by_file[upcard_idx][entry->final_result];
-                    if (records_by_file[upcard_idx][entry->final_result] && count < freq_buffer_count) {
-                        records_by_file[upcard_idx][entry->final_result][count].true_count = (float)entry->true_count;
-                        records_by_file[upcard_idx][entry->final_result][count].checksum = 
-                            calculate_freq_checksum(&records_by_file[upcard_idx][entry->final_result][count]);
-                        counts_by_file[upcard_idx][entry->final_result]++;
-                    }
-                }
-            }
-            
-            // Escrever todos os dados agrupados em lotes grandes
-            const char* final_names[] = {"17", "18", "19", "20", "21", "BJ", "BUST"};
-            for (int u = 0; u < 11; u++) {
-                for (int f = 0; f < 7; f++) {
-                    if (counts_by_file[u][f] > 0) {
-                        char result_filepath[512];
-                        int upcard_value = (u == 9) ? 11 : u + 2; // Converter índice de volta para upcard
-                        if (upcard_value == 11) {
-                            snprintf(result_filepath, sizeof(result_filepath), 
-                                    "temp_result_upcard_A_final_%s_batch_%d%s", 
-                                    final_names[f], batch_id, BINARY_SUFFIX);
-                        } else {
-                            snprintf(result_filepath, sizeof(result_filepath), 
-                                    "temp_result_upcard_%d_final_%s_batch_%d%s", 
-                                    upcard_value, final_names[f], batch_id, BINARY_SUFFIX);
-                        }
-                        
-                        FILE* result_file = fopen(result_filepath, "ab");
-                        if (result_file) {
-                            // Escrever tudo de uma vez
-                            size_t written = fwrite(records_by_file[u][f], sizeof(FreqBinaryRecord), counts_by_file[u][f], result_file);
-                            DEBUG_IO("Flush freq: escreveu %zu registros para %s", written, result_filepath);
-                            fclose(result_file);
-                        } else {
-                            DEBUG_IO("ERRO: Não foi possível abrir arquivo para flush: %s", result_filepath);
-                        }
-                    }
-                }
-            }
-            
-            // Liberar buffers
-            for (int u = 0; u < 11; u++) {
-                for (int f = 0; f < 7; f++) {
-                    free(records_by_file[u][f]);
-                }
-            }
-            
-            pthread_mutex_unlock(freq_mutex);
-            DEBUG_MUTEX("Mutex de frequência liberado");
-        }
-        
-        freq_buffer_count = 0;  // Reset buffer
-    }
-
-    // Função para flush do buffer de dealer - otimizada
-    void flush_dealer_buffer() {
-        if (dealer_buffer_count == 0) return;
-        
-        DEBUG_MUTEX("Flushing dealer buffer com %d registros", dealer_buffer_count);
-        
-        if (dealer_mutex && dealer_file) {
-            pthread_mutex_lock(dealer_mutex);
-            
-            for (int i = 0; i < dealer_buffer_count; i++) {
-                DealerBufferEntry* entry = &dealer_buffer[i];
-                write_dealer_binary(dealer_file, entry->true_count, entry->ace_upcard, entry->dealer_bj);
-            }
-            
-            pthread_mutex_unlock(dealer_mutex);
-        }
-        
-        dealer_buffer_count = 0;
-    }
-
     // Variável para controlar coleta duplicada de dados de frequência
     bool freq_data_collected_this_round = false;
 
+    // Shoe persistente da thread, reembaralhado no lugar a cada shoe.
+    // Volta à ordem canônica para que a simulação só dependa de (semente, sim_id).
+    Shoe *shoe = baralho_thread_shoe();
+    baralho_reiniciar(shoe);
+    ShoeRing *shoe_ring = shoe_pipeline_ring_thread();
+
     DEBUG_PRINT("Iniciando loop principal de shoes para simulação %d", sim_id);
 
     while (shoes_jogados < NUM_SHOES) {
         DEBUG_PRINT("Iniciando shoe %d de %d", shoes_jogados + 1, NUM_SHOES);
         
-        Shoe shoe;
-        baralho_criar(&shoe);
-        baralho_embaralhar(&shoe);
+        preparar_shoe(shoe, &rng, sim_id, shoes_jogados, shoe_ring, lazy_shuffle);
+        shoe->compras_sem_carta = 0;
         
-        // Inicializar ShoeCounter para este shoe
-        ShoeCounter shoe_counter;
-        shoe_counter_init(&shoe_counter, 8);  // 8 decks - já inicializa corretamente!
+        // Zerar contagens (ShoeCounter, running e true count) para este shoe
+        contador_cartas_iniciar(&contador, decks, shoe->total);
         
-        DEBUG_STATS("ShoeCounter inicializado: %d cartas totais", shoe_counter.total_cards);
+        DEBUG_STATS("ShoeCounter inicializado: %d cartas totais", contador.shoe.total_cards);
         
         // Jogar até atingir a penetração
-        size_t limite_penetracao = (size_t)(shoe.total * PENETRACAO);
-        DEBUG_STATS("Shoe criado: %zu cartas, limite penetração: %zu", shoe.total, limite_penetracao);
+        size_t limite_penetracao = (size_t)((size_t)decks * 52 * PENETRACAO);
+        DEBUG_STATS("Shoe criado: %zu cartas, limite penetração: %zu", shoe->total, limite_penetracao);
         
-        while (shoe.topo <= limite_penetracao) {
+        while (shoe->topo <= limite_penetracao) {
             // Reset da flag para nova rodada
             freq_data_collected_this_round = false;
             
@@ -458,18 +429,20 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                 goto finish_simulation;
             }
             
+            rodadas++;
+            
             // Calcular mãos contabilizadas baseado no true count atual
-            int maos_contabilizadas = calcular_maos_contabilizadas(true_count);
-            int total_maos = NUM_JOGADORES + maos_contabilizadas;
+            int maos_contabilizadas = calcular_maos_contabilizadas(contador.true_count);
+            int total_maos = num_jogadores + maos_contabilizadas;
             
-            DEBUG_STATS("Rodada: TC=%.3f, mãos_contab=%d, total_maos=%d", true_count, maos_contabilizadas, total_maos);
+            DEBUG_STATS("Rodada: TC=%.3f, mãos_contab=%d, total_maos=%d", contador.true_count, maos_contabilizadas, total_maos);
             
             // Atualizar unidade baseada no bankroll
             unidade_atual = calcular_unidade(bankroll);
             
             // Calcular aposta usando o sistema de progressão
-            size_t cartas_restantes = shoe.total - shoe.topo;
-            int bet = definir_aposta(cartas_restantes, vitorias, true_count, maos_jogadas, loss_shoe, unidade_atual);
+            size_t cartas_restantes = shoe->total - shoe->topo;
+            int bet = definir_aposta(cartas_restantes, vitorias, contador.true_count, maos_jogadas, loss_shoe, unidade_atual, rampa_thread);
             
             DEBUG_STATS("Aposta calculada: %d unidades (%.2f), bankroll=%.2f", bet, unidade_atual, bankroll);
             
@@ -493,74 +466,34 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             DEBUG_PRINT("Distribuindo cartas - primeira rodada");
             
             // Primeira rodada de distribuição - primeiro jogadores normais, depois mãos contabilizadas
-            // Distribuir para jogadores normais (índices 0 a NUM_JOGADORES-1)
-            for (int i = 0; i < NUM_JOGADORES; ++i) {
-                Carta c = baralho_comprar(&shoe);
+            // Distribuir para jogadores normais (índices 0 a num_jogadores-1)
+            for (int i = 0; i < num_jogadores; ++i) {
+                Carta c = contador_cartas_comprar(&contador, shoe, NULL);
                 adicionar_carta(&maos_bits[i], c);
-                atualizar_counts(&running_count, &true_count, c, shoe.total - shoe.topo);
-                
-                // Atualizar ShoeCounter
-                int rank_idx = carta_para_rank_idx(c);
-                if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter.counts[rank_idx] > 0) {
-                    shoe_counter.counts[rank_idx]--;
-                    shoe_counter.total_cards--;
-                }
             }
-            // Distribuir para mãos contabilizadas (índices NUM_JOGADORES a total_maos-1)
-            for (int i = NUM_JOGADORES; i < total_maos; ++i) {
-                Carta c = baralho_comprar(&shoe);
+            // Distribuir para mãos contabilizadas (índices num_jogadores a total_maos-1)
+            for (int i = num_jogadores; i < total_maos; ++i) {
+                Carta c = contador_cartas_comprar(&contador, shoe, NULL);
                 adicionar_carta(&maos_bits[i], c);
-                atualizar_counts(&running_count, &true_count, c, shoe.total - shoe.topo);
-                
-                // Atualizar ShoeCounter
-                int rank_idx = carta_para_rank_idx(c);
-                if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter.counts[rank_idx] > 0) {
-                    shoe_counter.counts[rank_idx]--;
-                    shoe_counter.total_cards--;
-                }
             }
             
             // Dealer recebe upcard
-            Carta c = baralho_comprar(&shoe);
+            Carta c = contador_cartas_comprar(&contador, shoe, NULL);
             adicionar_carta(&dealer_mao, c);
             Carta dealer_upcard = c;
-            atualizar_counts(&running_count, &true_count, c, shoe.total - shoe.topo);
-            
-            // Atualizar ShoeCounter com dealer upcard
-            int dealer_rank_idx = carta_para_rank_idx(c);
-            if (dealer_rank_idx >= 0 && dealer_rank_idx < NUM_RANKS && shoe_counter.counts[dealer_rank_idx] > 0) {
-                shoe_counter.counts[dealer_rank_idx]--;
-                shoe_counter.total_cards--;
-            }
 
             DEBUG_PRINT("Distribuindo cartas - segunda rodada");
             
             // Segunda rodada de distribuição - primeiro jogadores normais, depois mãos contabilizadas
-            // Distribuir para jogadores normais (índices 0 a NUM_JOGADORES-1)
-            for (int i = 0; i < NUM_JOGADORES; ++i) {
-                c = baralho_comprar(&shoe);
+            // Distribuir para jogadores normais (índices 0 a num_jogadores-1)
+            for (int i = 0; i < num_jogadores; ++i) {
+                c = contador_cartas_comprar(&contador, shoe, NULL);
                 adicionar_carta(&maos_bits[i], c);
-                atualizar_counts(&running_count, &true_count, c, shoe.total - shoe.topo);
-                
-                // Atualizar ShoeCounter
-                int rank_idx = carta_para_rank_idx(c);
-                if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter.counts[rank_idx] > 0) {
-                    shoe_counter.counts[rank_idx]--;
-                    shoe_counter.total_cards--;
-                }
             }
-            // Distribuir para mãos contabilizadas (índices NUM_JOGADORES a total_maos-1)
-            for (int i = NUM_JOGADORES; i < total_maos; ++i) {
-                c = baralho_comprar(&shoe);
+            // Distribuir para mãos contabilizadas (índices num_jogadores a total_maos-1)
+            for (int i = num_jogadores; i < total_maos; ++i) {
+                c = contador_cartas_comprar(&contador, shoe, NULL);
                 adicionar_carta(&maos_bits[i], c);
-                atualizar_counts(&running_count, &true_count, c, shoe.total - shoe.topo);
-                
-                // Atualizar ShoeCounter
-                int rank_idx = carta_para_rank_idx(c);
-                if (rank_idx >= 0 && rank_idx < NUM_RANKS && shoe_counter.counts[rank_idx] > 0) {
-                    shoe_counter.counts[rank_idx]--;
-                    shoe_counter.total_cards--;
-                }
             }
             
             // *** PONTO CRÍTICO: CAPTURAR TRUE COUNT PARA ESTATÍSTICAS ***
@@ -568,19 +501,31 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             // - Todos jogadores receberam 2 cartas (TC atualizado)
             // - Dealer recebeu upcard (TC atualizado)
             // - Dealer ainda NÃO recebeu hole card
-            double true_count_for_stats = true_count;
+            double true_count_for_stats = contador.true_count;
+            // Bin exato do mesmo TC para os histogramas de frequência;
+            // TCs a partir de MAX_TC ficam fora, como sempre ficaram
+            int tc_bin_for_stats = -1;
+            if (any_freq_analysis && true_count_for_stats < MAX_TC) {
+                tc_bin_for_stats = contador_cartas_bin_tc(&contador);
+            }
             
             DEBUG_STATS("TC capturado para estatísticas: %.3f (antes do hole card)", true_count_for_stats);
             
             // Dealer recebe hole card (NÃO CONTABILIZAR AINDA)
-            c = baralho_comprar(&shoe);
+            c = baralho_comprar(shoe);
             adicionar_carta(&dealer_mao, c);
             dealer_hole_card = c;
             
+            // Shoe acabou na distribuição: rodada anulada, shoe encerrado
+            if (__builtin_expect(shoe->compras_sem_carta != 0, 0)) {
+                anular_rodada(&rodadas, &rodadas_anuladas, maos_bits, total_maos);
+                break;
+            }
+            
             // Calcular rank do upcard do dealer - otimizado
             int dealer_up_rank;
 #if defined(__GNUC__)
-            int bit_pos = __builtin_ctzll(dealer_upcard) / 3;
+            int bit_pos = __builtin_ctzll(dealer_upcard) / MAO_BITS_POR_RANK;
             // Lookup table para conversão rápida
             static const int rank_table[13] = {2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 11};
             dealer_up_rank = rank_table[bit_pos];
@@ -608,16 +553,16 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             int maos_contabilizadas_count = 0;
             
             // Contar mãos contabilizadas
-            for (int pj = NUM_JOGADORES; pj < total_maos; ++pj) {
+            for (int pj = num_jogadores; pj < total_maos; ++pj) {
                 maos_contabilizadas_count++;
             }
             
             // Calcular porcentagem de cartas de rank 10 no baralho (otimizado)
-            int ten_cards_count = shoe_counter.counts[8] + shoe_counter.counts[9] + 
-                                 shoe_counter.counts[10] + shoe_counter.counts[11]; // 10,J,Q,K
-            double ten_cards_percentage = (double)ten_cards_count / shoe_counter.total_cards;
+            int ten_cards_count = contador.shoe.counts[8] + contador.shoe.counts[9] + 
+                                 contador.shoe.counts[10] + contador.shoe.counts[11]; // 10,J,Q,K
+            double ten_cards_percentage = (double)ten_cards_count / contador.shoe.total_cards;
             
-            if (dealer_up_rank == 11 && true_count >= MIN_COUNT_INS && maos_contabilizadas_count > 0 && ten_cards_percentage >= TEN_perc) {
+            if (dealer_up_rank == 11 && contador.true_count >= MIN_COUNT_INS && maos_contabilizadas_count > 0 && ten_cards_percentage >= TEN_perc) {
                 insurance_bet = (bet / 2.0) * maos_contabilizadas_count;
                 made_insurance = true;
                 DEBUG_STATS("Insurance feito: %.2f unidades (10%%=%.2f%%)", insurance_bet, ten_cards_percentage * 100.0);
@@ -627,35 +572,20 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             if (dealer_up_rank == 11) {
                 DEBUG_PRINT("Dealer tem upcard Ás - verificando blackjack");
                 
-                // Coletar dados de insurance se análise está ativada - usando buffer otimizado
-                if (insurance_analysis) {
-                    if (insurance_buffer_count < INSURANCE_BUFFER_THRESHOLD) {
-                        insurance_buffer[insurance_buffer_count].ten_cards_percentage = (float)ten_cards_percentage;
-                        insurance_buffer[insurance_buffer_count].dealer_blackjack = dealer_info.blackjack ? 1 : 0;
-                        insurance_buffer_count++;
-                        
-                        // Flush buffer quando quase cheio
-                        if (insurance_buffer_count >= INSURANCE_BUFFER_THRESHOLD) {
-                            flush_insurance_buffer();
-                        }
+                // Análises de dealer BJ e insurance: TC e densidade de dez NO MOMENTO
+                // DA DECISÃO DE INSURANCE (sem conhecer o hole card do dealer)
+                if (dealer_analysis) {
+                    int tc_bin = contador_cartas_bin_tc(&contador);
+                    if (tc_bin >= 0) {
+                        dealer_bj_thread[tc_bin].ases++;
+                        dealer_bj_thread[tc_bin].blackjacks += dealer_info.blackjack ? 1 : 0;
                     }
                 }
-                
-                // Coletar dados do dealer se análise está ativada - usando buffer
-                // IMPORTANTE: Usar true_count NO MOMENTO DA DECISÃO DE INSURANCE
-                // (sem conhecer o hole card do dealer)
-                if (dealer_analysis && dealer_buffer_count < DEALER_BUFFER_THRESHOLD) {
-                    dealer_buffer[dealer_buffer_count].true_count = true_count;
-                    dealer_buffer[dealer_buffer_count].ace_upcard = 1;
-                    dealer_buffer[dealer_buffer_count].dealer_bj = dealer_info.blackjack ? 1 : 0;
-                    dealer_buffer_count++;
-                    
-                    DEBUG_STATS("Dados dealer adicionados ao buffer: TC=%.3f, BJ=%d", 
-                               true_count, dealer_info.blackjack ? 1 : 0);
-                    
-                    // Flush buffer quando quase cheio
-                    if (dealer_buffer_count >= DEALER_BUFFER_THRESHOLD) {
-                        flush_dealer_buffer();
+                if (insurance_analysis) {
+                    int dens_bin = insurance_bin(ten_cards_count, contador.shoe.total_cards);
+                    if (dens_bin >= 0) {
+                        insurance_thread[dens_bin].ases++;
+                        insurance_thread[dens_bin].blackjacks += dealer_info.blackjack ? 1 : 0;
                     }
                 }
                 
@@ -664,14 +594,7 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                     DEBUG_PRINT("Dealer tem BLACKJACK");
                     
                     // Dealer tem BJ - contabilizar hole card
-                    atualizar_counts(&running_count, &true_count, dealer_hole_card, shoe.total - shoe.topo);
-                    
-                    // Atualizar ShoeCounter com a hole card revelada
-                    int hole_rank_idx = carta_para_rank_idx(dealer_hole_card);
-                    if (hole_rank_idx >= 0 && hole_rank_idx < NUM_RANKS && shoe_counter.counts[hole_rank_idx] > 0) {
-                        shoe_counter.counts[hole_rank_idx]--;
-                        shoe_counter.total_cards--;
-                    }
+                    contador_cartas_registrar(&contador, carta_para_rank_idx(dealer_hole_card), shoe->total - shoe->topo);
                     
                     // Aplicar ganho do insurance se foi feito
                     if (made_insurance) {
@@ -700,7 +623,7 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                         mao_jogador.finalizada = true; // Não jogam
                         
                         // Marcar mãos contabilizadas
-                        if (pj >= NUM_JOGADORES) {
+                        if (pj >= num_jogadores) {
                             mao_jogador.contabilizada = true;
                         }
                         
@@ -740,12 +663,11 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                         }
                     }
                     
-                    // Adicionar unidades da rodada à variável global
+                    // Adicionar unidades da rodada ao resultado da simulação
                     if (pnl_rodada_total != 0.0) {
                         double unidades_rodada = pnl_rodada_total / unidade_atual;
-                        pthread_mutex_lock(&unidades_mutex);
-                        unidades_total_global += unidades_rodada;
-                        pthread_mutex_unlock(&unidades_mutex);
+                        unidades_shoe += unidades_rodada;
+                        soma_compensada_adicionar(&unidades_sim, unidades_rodada);
                     }
                     
                     // Coletar dados de frequência apenas UMA VEZ quando dealer tem BJ
@@ -765,7 +687,7 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                             should_collect = true;
                         }
                         
-                        if (should_collect && freq_buffer_count < FREQ_BUFFER_THRESHOLD) {
+                        if (should_collect) {
                             // Determinar resultado final do dealer - otimizado
                             int final_result = -1;
                             if (dealer_info.blackjack) {
@@ -776,27 +698,11 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                                 final_result = 6; // BUST
                             }
                             
-                            // Adicionar ao buffer local - CORREÇÃO: usar true_count_for_stats
-                            freq_buffer[freq_buffer_count].true_count = true_count_for_stats;
-                            freq_buffer[freq_buffer_count].upcard = dealer_up_rank;
-                            freq_buffer[freq_buffer_count].final_result = final_result;
-                            freq_buffer_count++;
-
-                            // NOVO: registrar ocorrência total deste upcard - CORREÇÃO: usar true_count_for_stats
-                            int upcard_index = (dealer_up_rank == 11) ? 9 : dealer_up_rank - 2;
-                            if (upcard_index >= 0 && upcard_index < 11 && freq_total_files[upcard_index]) {
-                                write_freq_binary(freq_total_files[upcard_index], true_count_for_stats);
-                            }
-                            
+                            freq_registrar(dealer_up_rank, final_result, tc_bin_for_stats);
                             freq_data_collected_this_round = true; // Marcar como coletado
                             
                             DEBUG_STATS("Dados freq coletados (dealer BJ): TC=%.3f, upcard=%d, final=%d", 
                                        true_count_for_stats, dealer_up_rank, final_result);
-                            
-                            // Flush buffer quando quase cheio para maior eficiência
-                            if (freq_buffer_count >= FREQ_BUFFER_THRESHOLD) {
-                                flush_freq_buffer();
-                            }
                         }
                     }
                     
@@ -817,48 +723,58 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             
             DEBUG_PRINT("Jogadores vão jogar suas mãos");
             
-            // Primeiro, todos os jogadores jogam
-            Mao all_hands[70]; // máximo 7 jogadores x 10 mãos cada
+            // Primeiro, todos os jogadores jogam, cada mão na sua vaga da arena
+            const bool usa_frias = log_file || split_analysis;
             int total_hands = 0;
             
             for (int pj = 0; pj < total_maos; ++pj) {
                 DEBUG_PRINT("Jogador %d jogando", pj);
                 
-                Mao hands[10];
-                int hand_count = 1;
-                avaliar_mao(maos_bits[pj], &hands[0]);
-                hands[0].aposta = bet;
+                const int primeira = total_hands;
+                Mao *inicial = &arena_maos[total_hands++];
+                avaliar_mao(maos_bits[pj], inicial);
+                inicial->aposta = bet;
+                if (usa_frias) {
+                    inicial->fria = &arena_frias[primeira];
+                    mao_fria_inicializar(inicial->fria);
+                }
                 
                 // Marcar mãos contabilizadas
-                if (pj >= NUM_JOGADORES) {
-                    hands[0].contabilizada = true;
+                if (pj >= num_jogadores) {
+                    inicial->contabilizada = true;
                 }
                 
-                for (int h = 0; h < hand_count; ++h) {
-                    Mao *nova = &hands[hand_count];
-                    Mao *m = &hands[h];
-                    Mao *split_result = jogar_mao(m, &shoe, dealer_up_rank, nova, &running_count, &true_count, &shoe_counter, ev_realtime_enabled);
-                    if (split_result) {
+                for (int h = primeira; h < total_hands; ++h) {
+                    // Vaga para uma eventual mão de split; com a arena cheia a
+                    // vaga de descarte evita estouro (não ocorre com 10 assentos)
+                    int vaga = total_hands < MAX_MAOS_ARENA ? total_hands : MAX_MAOS_ARENA;
+                    Mao *nova = &arena_maos[vaga];
+                    nova->fria = usa_frias ? &arena_frias[vaga] : NULL;
+                    Mao *m = &arena_maos[h];
+                    Mao *split_result = jogar_mao(m, shoe, dealer_up_rank, nova, &contador, ev_realtime_enabled);
+                    if (split_result && vaga < MAX_MAOS_ARENA) {
                         split_result->aposta = bet;
                         // Mãos split herdam o status de contabilizada
                         split_result->contabilizada = m->contabilizada;
-                        hand_count++;
+                        total_hands++;
                         DEBUG_PRINT("Split detectado para jogador %d", pj);
                     }
                 }
                 
                 // Coletar dados de split se análise está ativada e houve split
-                if (split_analysis && hand_count >= 2) {
+                Mao *mao1 = &arena_maos[primeira];
+                Mao *mao2 = &arena_maos[primeira + 1];
+                if (split_analysis && total_hands - primeira >= 2) {
                     DEBUG_PRINT("Processando dados de split para jogador %d", pj);
                     
                     // Verificar se as mãos vieram de split
-                    if (hands[0].from_split && hands[1].from_split) {
+                    if (mao1->from_split && mao2->from_split) {
                         // Verificar se é um dos pares que analisamos (10 pares)
                         int pair_index = -1;
                         int upcard_index = -1;
 
                         // Rank do par salvo durante o split (0=2 … 12=A)
-                        int rank_idx = hands[0].split_rank_idx;
+                        int rank_idx = mao1->split_rank_idx;
                         if (rank_idx >= 0 && rank_idx <= 12) {
                             // Mapeamento para 10 pares: AA(12)->0, 1010(8)->1, 99(7)->2, 88(6)->3, 77(5)->4, 66(4)->5, 55(3)->6, 44(2)->7, 33(1)->8, 22(0)->9
                             // Removidos JJ(9), QQ(10), KK(11)
@@ -884,52 +800,44 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                                    rank_idx, pair_index, upcard_index);
                         
                         // Se é um par/upcard que analisamos, registrar os dados
-                        if (pair_index >= 0 && pair_index < 10 && upcard_index >= 0 && upcard_index < 10 && split_files[pair_index][upcard_index]) {
-                            DEBUG_MUTEX("Obtendo mutex de split");
-                            pthread_mutex_lock(split_mutex);
-                            
+                        if (pair_index >= 0 && pair_index < 10 && upcard_index >= 0 && upcard_index < 10) {
                             // Contar cartas usadas (4 iniciais + cartas adicionais)
                             int total_cards_initial = 4; // 2 cartas por mão inicialmente
-                            int cards_mao1 = __builtin_popcountll(hands[0].bits) - __builtin_popcountll(hands[0].initial_bits);
-                            int cards_mao2 = __builtin_popcountll(hands[1].bits) - __builtin_popcountll(hands[1].initial_bits);
+                            int cards_mao1 = __builtin_popcountll(mao1->bits) - __builtin_popcountll(mao1->initial_bits);
+                            int cards_mao2 = __builtin_popcountll(mao2->bits) - __builtin_popcountll(mao2->initial_bits);
                             int total_cards_used = total_cards_initial + cards_mao1 + cards_mao2;
                             
                             // As mãos ainda não têm resultado calculado, então vamos aguardar
-                            // Marcar as mãos para processamento posterior
-                            hands[0].split_pair_index = pair_index;
-                            hands[0].split_upcard_index = upcard_index;
-                            hands[0].split_cards_used = total_cards_used;
-                            hands[1].split_pair_index = pair_index;
-                            hands[1].split_upcard_index = upcard_index;
-                            hands[1].split_cards_used = total_cards_used;
+                            // Marcar as mãos (dados frios, locais à thread) para processamento posterior
+                            mao1->fria->split_pair_index = pair_index;
+                            mao1->fria->split_upcard_index = upcard_index;
+                            mao1->fria->split_cards_used = total_cards_used;
+                            mao2->fria->split_pair_index = pair_index;
+                            mao2->fria->split_upcard_index = upcard_index;
+                            mao2->fria->split_cards_used = total_cards_used;
                             
                             DEBUG_STATS("Split configurado para análise posterior: %d cartas usadas", total_cards_used);
-                            
-                            pthread_mutex_unlock(split_mutex);
-                            DEBUG_MUTEX("Mutex de split liberado");
                         }
                     }
                 }
-                
-                // Copiar todas as mãos para o array global
-                for (int h = 0; h < hand_count; ++h) {
-                    all_hands[total_hands++] = hands[h];
-                }
             }
             
             DEBUG_PRINT("Dealer vai jogar - contabilizando hole card");
             
             // Agora que todos jogaram, dealer conta hole card e joga
-            atualizar_counts(&running_count, &true_count, dealer_hole_card, shoe.total - shoe.topo);
+            contador_cartas_registrar(&contador, carta_para_rank_idx(dealer_hole_card), shoe->total - shoe->topo);
             
-            // Atualizar ShoeCounter com a hole card revelada
-            int hole_rank_idx = carta_para_rank_idx(dealer_hole_card);
-            if (hole_rank_idx >= 0 && hole_rank_idx < NUM_RANKS && shoe_counter.counts[hole_rank_idx] > 0) {
-                shoe_counter.counts[hole_rank_idx]--;
-                shoe_counter.total_cards--;
-            }
+            avaliar_mao_dealer(&dealer_info, shoe, &contador);
             
-            avaliar_mao_dealer(&dealer_info, &shoe, &running_count, &true_count);
+            // Shoe acabou durante o jogo: nada da rodada foi registrado além da
+            // perda do insurance, que é desfeita
+            if (__builtin_expect(shoe->compras_sem_carta != 0, 0)) {
+                if (made_insurance) {
+                    bankroll += insurance_bet;
+                }
+                anular_rodada(&rodadas, &rodadas_anuladas, maos_bits, total_maos);
+                break;
+            }
             if (log_level > 0) {
                 mao_para_string(dealer_info.bits, dealer_final_str);
             }
@@ -951,7 +859,7 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                     should_collect = true;
                 }
                 
-                if (should_collect && freq_buffer_count < FREQ_BUFFER_THRESHOLD) {
+                if (should_collect) {
                     // Determinar resultado final do dealer - otimizado
                     int final_result = -1;
                     if (dealer_info.blackjack) {
@@ -962,27 +870,11 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                         final_result = 6; // BUST
                     }
                     
-                    // Adicionar ao buffer local - CORREÇÃO: usar true_count_for_stats
-                    freq_buffer[freq_buffer_count].true_count = true_count_for_stats;
-                    freq_buffer[freq_buffer_count].upcard = dealer_up_rank;
-                    freq_buffer[freq_buffer_count].final_result = final_result;
-                    freq_buffer_count++;
-
-                    // NOVO: registrar ocorrência total deste upcard - CORREÇÃO: usar true_count_for_stats
-                    int upcard_index = (dealer_up_rank == 11) ? 9 : dealer_up_rank - 2;
-                    if (upcard_index >= 0 && upcard_index < 11 && freq_total_files[upcard_index]) {
-                        write_freq_binary(freq_total_files[upcard_index], true_count_for_stats);
-                    }
-                    
+                    freq_registrar(dealer_up_rank, final_result, tc_bin_for_stats);
                     freq_data_collected_this_round = true; // Marcar como coletado
                     
                     DEBUG_STATS("Dados freq coletados (dealer final): TC=%.3f, upcard=%d, final=%d", 
                                true_count_for_stats, dealer_up_rank, final_result);
-                    
-                    // Flush buffer quando quase cheio
-                    if (freq_buffer_count >= FREQ_BUFFER_THRESHOLD) {
-                        flush_freq_buffer();
-                    }
                 }
             }
             
@@ -996,12 +888,25 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             
             DEBUG_PRINT("Verificando resultados de todas as mãos");
             
+            // Liquidar todas as mãos de uma vez contra o dealer
+            for (int i = 0; i < total_hands; ++i) {
+                const Mao *m = &arena_maos[i];
+                liq_valor[i] = m->valor;
+                liq_flags[i] = (m->blackjack ? LIQ_BLACKJACK : 0u) |
+                               (m->isdouble ? LIQ_DOUBLE : 0u) |
+                               (m->valor > 21 ? LIQ_BUST : 0u);
+                liq_aposta[i] = m->aposta;
+            }
+            uint32_t dealer_flags = (dealer_info.blackjack ? LIQ_BLACKJACK : 0u) |
+                                    (dealer_info.valor > 21 ? LIQ_BUST : 0u);
+            liquidar_maos(total_hands, liq_valor, liq_flags, liq_aposta, dealer_info.valor, dealer_flags,
+                          liq_resultado, liq_pnl);
+            
             // Agora salvar todos os resultados
             for (int i = 0; i < total_hands; ++i) {
-                Mao *m = &all_hands[i];
-                
-                verificar_mao(m, &dealer_info);
-                calcular_pnl(m);
+                Mao *m = &arena_maos[i];
+                m->resultado = "DEV"[liq_resultado[i] + 1];
+                m->pnl = liq_pnl[i];
 
                 // Atualizar estatísticas apenas para mãos contabilizadas
                 if (m->contabilizada) {
@@ -1032,7 +937,7 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
                     
                     fprintf(log_file, "%s,%c,%s,%s,%d,%s,%c,%.1f,%.1f,%c,%c,%c,%c\n", 
                            init_str, upcard_char, 
-                           (m->hist_len>0?m->historico:"-"), final_str, m->valor, 
+                           (m->fria->hist_len>0?m->fria->historico:"-"), final_str, m->valor, 
                            dealer_final_str, m->resultado, m->aposta, m->pnl,
                            m->isdouble ? 'S' : 'N',
                            m->from_split ? 'S' : 'N',
@@ -1043,82 +948,52 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             }
             
             // Processar dados de split após calcular todos os resultados
-            if (split_analysis && split_mutex) {
+            if (split_analysis) {
                 DEBUG_PRINT("Processando dados de split finais");
                 
                 // Buscar pares de mãos de split para registrar dados
                 for (int i = 0; i < total_hands - 1; i++) {
-                    Mao *m1 = &all_hands[i];
+                    Mao *m1 = &arena_maos[i];
+                    MaoFria *f1 = m1->fria;
                     
                     // Verificar se é uma mão de split
-                    if (m1->from_split && m1->split_pair_index >= 0) {
+                    if (m1->from_split && f1->split_pair_index >= 0) {
                         // Buscar a mão par correspondente
                         for (int j = i + 1; j < total_hands; j++) {
-                            Mao *m2 = &all_hands[j];
+                            Mao *m2 = &arena_maos[j];
+                            MaoFria *f2 = m2->fria;
                             
                             if (m2->from_split && 
-                                m2->split_pair_index == m1->split_pair_index &&
-                                m2->split_upcard_index == m1->split_upcard_index) {
+                                f2->split_pair_index == f1->split_pair_index &&
+                                f2->split_upcard_index == f1->split_upcard_index) {
                                 
                                 DEBUG_PRINT("Registrando dados de split para pair_index=%d, upcard_index=%d", 
-                                           m1->split_pair_index, m1->split_upcard_index);
+                                           f1->split_pair_index, f1->split_upcard_index);
                                 
-                                // Registrar dados do split
-                                pthread_mutex_lock(split_mutex);
+                                DEBUG_STATS("Split resultado: mão1=%c, mão2=%c", m1->resultado, m2->resultado);
                                 
-                                if (m1->split_pair_index >= 0 && m1->split_pair_index < 10 && 
-                                    m1->split_upcard_index >= 0 && m1->split_upcard_index < 10 &&
-                                    split_files[m1->split_pair_index][m1->split_upcard_index]) {
-                                    
-                                    // Calcular combinações reais dos resultados
-                                    int mao1_win = (m1->resultado == 'V') ? 1 : 0;
-                                    int mao1_push = (m1->resultado == 'E') ? 1 : 0;
-                                    int mao1_lose = (m1->resultado == 'D') ? 1 : 0;
-                                    
-                                    int mao2_win = (m2->resultado == 'V') ? 1 : 0;
-                                    int mao2_push = (m2->resultado == 'E') ? 1 : 0;
-                                    int mao2_lose = (m2->resultado == 'D') ? 1 : 0;
-                                    
-                                    // Calcular combinações reais de resultados
-                                    int lose_lose = (mao1_lose && mao2_lose) ? 1 : 0;
-                                    int win_win = (mao1_win && mao2_win) ? 1 : 0;
-                                    int push_push = (mao1_push && mao2_push) ? 1 : 0;
-                                    int lose_win = (mao1_lose && mao2_win) ? 1 : 0;
-                                    int lose_push = (mao1_lose && mao2_push) ? 1 : 0;
-                                    int win_lose = (mao1_win && mao2_lose) ? 1 : 0;
-                                    int win_push = (mao1_win && mao2_push) ? 1 : 0;
-                                    int push_lose = (mao1_push && mao2_lose) ? 1 : 0;
-                                    int push_win = (mao1_push && mao2_win) ? 1 : 0;
-                                    
-                                    DEBUG_STATS("Split resultado: mão1=%c, mão2=%c, combinação LL=%d WW=%d PP=%d", 
-                                               m1->resultado, m2->resultado, lose_lose, win_win, push_push);
-                                    
-                                    write_split_binary(split_files[m1->split_pair_index][m1->split_upcard_index],
-                                                     true_count, lose_lose, win_win, push_push, lose_win, 
-                                                     lose_push, win_lose, win_push, push_lose, push_win, 
-                                                     m1->split_cards_used);
-                                }
-                                
-                                pthread_mutex_unlock(split_mutex);
+                                // Bin do TC no momento da liquidação, como antes
+                                split_registrar(f1->split_pair_index, f1->split_upcard_index,
+                                                contador_cartas_bin_tc(&contador),
+                                                m1->resultado, m2->resultado, f1->split_cards_used);
                                 
                                 // Marcar mãos como processadas para evitar duplicação
-                                m2->split_pair_index = -1;
+                                f2->split_pair_index = -1;
                                 break;
                             }
                         }
                         
                         // Marcar mão como processada
-                        m1->split_pair_index = -1;
+                        f1->split_pair_index = -1;
                     }
                 }
             }
             
-            // Adicionar unidades da rodada à variável global
+            // Adicionar unidades da rodada ao resultado da simulação
             if (pnl_rodada_total != 0.0) {
                 double unidades_rodada = pnl_rodada_total / unidade_atual;
-                pthread_mutex_lock(&unidades_mutex);
-                unidades_total_global += unidades_rodada;
-                pthread_mutex_unlock(&unidades_mutex);
+                unidades_shoe += unidades_rodada;
+                soma_compensada_adicionar(&unidades_sim, unidades_rodada);
                 
                 DEBUG_STATS("PNL rodada: %.4f unidades", unidades_rodada);
             }
@@ -1129,10 +1004,11 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
             }
         }
         
-        baralho_destruir(&shoe);
+        if (unidades_por_shoe_thread) {
+            unidades_por_shoe_thread[shoes_jogados] = unidades_shoe;
+        }
+        unidades_shoe = 0.0;
         shoes_jogados++;
-        running_count = 0.0; // Reset para novo shoe
-        true_count = 0.0;    // Reset true count também
         pnl_shoe = 0.0;      // Reset PNL do shoe
         loss_shoe = 0.0;     // Reset perdas do shoe
         
@@ -1141,62 +1017,78 @@ void simulacao_completa(int log_level, int sim_id, const char* output_suffix, at
     
     finish_simulation:
     DEBUG_PRINT("Finalizando simulação %d", sim_id);
+    // Simulação interrompida pelo limite de log: as embaralhadoras publicam
+    // sempre NUM_SHOES shoes por simulação, então os que sobraram saem do ring
+    if (shoe_ring) {
+        for (int s = shoes_jogados + 1; s < NUM_SHOES; ++s) {
+            shoe_pipeline_descartar(shoe_ring, sim_id, s);
+        }
+    }
+    unidades_registrar_sim(soma_compensada_valor(&unidades_sim), rodadas, rodadas_anuladas);
     
     if (log_file) {
         fclose(log_file);
         DEBUG_IO("Arquivo de log fechado");
     }
     
-    if (dealer_file) {
-        fclose(dealer_file);
-        DEBUG_IO("Arquivo de dealer fechado");
-    }
-    
-    // Fechar arquivos de frequência
-    if (any_freq_analysis) {
-        // Fechar arquivos de total
-        for (int i = 0; i < 11; i++) {
-            if (freq_total_files[i]) {
-                fclose(freq_total_files[i]);
-            }
-        }
-        
-        // Fechar arquivos de resultado
-        for (int i = 0; i < 11; i++) {
-            for (int j = 0; j < 7; j++) {
-                if (freq_result_files[i][j]) {
-                    fclose(freq_result_files[i][j]);
-                }
-            }
-        }
-        DEBUG_IO("Arquivos de frequência fechados");
-    }
-    
-    // Fechar arquivos de split
-    if (split_analysis) {
-        for (int p = 0; p < 10; p++) {
-            for (int u = 0; u < 10; u++) {
-                if (split_files[p][u]) {
-                    fclose(split_files[p][u]);
-                }
-            }
-        }
-        DEBUG_IO("Arquivos de split fechados");
-    }
+    DEBUG_PRINT("Simulação %d concluída com sucesso", sim_id);
+}
 
-    // Flush todos os buffers no final da simulação
-    if (freq_buffer_count > 0) {
-        DEBUG_PRINT("Flush final do buffer de frequência");
-        flush_freq_buffer();
-    }
-    if (dealer_buffer_count > 0) {
-        DEBUG_PRINT("Flush final do buffer de dealer");
-        flush_dealer_buffer();
+
+// Instâncias especializadas para as mesas comuns (6/8 baralhos, 4 a 7 lugares),
+// cada uma em duas versões: completa (flags de análise, log e EV testadas em
+// tempo de execução) e enxuta (estratégia básica sem análises nem log)
+#define SIMULACAO_INSTANCIA_REC(NOME, D, J, REC) \
+    static __attribute__((noinline)) void NOME(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis, uint64_t rng_seed_base, bool lazy_shuffle) { \
+        simulacao_kernel(log_level, sim_id, output_suffix, global_log_count, dealer_analysis, freq_analysis_26, freq_analysis_70, freq_analysis_A, split_analysis, ev_realtime_enabled, insurance_analysis, rng_seed_base, lazy_shuffle, D, J, REC); \
     }
-    if (insurance_buffer_count > 0) {
-        DEBUG_PRINT("Flush final do buffer de insurance");
-        flush_insurance_buffer();
+#define SIMULACAO_INSTANCIA(D, J) \
+    SIMULACAO_INSTANCIA_REC(simulacao_##D##d_##J##j, D, J, REC_TODOS) \
+    SIMULACAO_INSTANCIA_REC(simulacao_enxuta_##D##d_##J##j, D, J, 0u)
+
+SIMULACAO_INSTANCIA(6, 4) SIMULACAO_INSTANCIA(6, 5) SIMULACAO_INSTANCIA(6, 6) SIMULACAO_INSTANCIA(6, 7)
+SIMULACAO_INSTANCIA(8, 4) SIMULACAO_INSTANCIA(8, 5) SIMULACAO_INSTANCIA(8, 6) SIMULACAO_INSTANCIA(8, 7)
+
+// Caminho genérico para valores arbitrários
+SIMULACAO_INSTANCIA_REC(simulacao_generica, DECKS, NUM_JOGADORES, REC_TODOS)
+SIMULACAO_INSTANCIA_REC(simulacao_generica_enxuta, DECKS, NUM_JOGADORES, 0u)
+
+typedef void (*SimulacaoFn)(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis, uint64_t rng_seed_base, bool lazy_shuffle);
+
+static SimulacaoFn selecionar_simulacao(int decks, int jogadores, bool enxuta) {
+    static const SimulacaoFn especializadas[2][2][4] = {
+        {
+            { simulacao_6d_4j, simulacao_6d_5j, simulacao_6d_6j, simulacao_6d_7j },
+            { simulacao_8d_4j, simulacao_8d_5j, simulacao_8d_6j, simulacao_8d_7j },
+        },
+        {
+            { simulacao_enxuta_6d_4j, simulacao_enxuta_6d_5j, simulacao_enxuta_6d_6j, simulacao_enxuta_6d_7j },
+            { simulacao_enxuta_8d_4j, simulacao_enxuta_8d_5j, simulacao_enxuta_8d_6j, simulacao_enxuta_8d_7j },
+        },
+    };
+    if ((decks == 6 || decks == 8) && jogadores >= 4 && jogadores <= 7) {
+        return especializadas[enxuta][decks == 8][jogadores - 4];
     }
-    
-    DEBUG_PRINT("Simulação %d concluída com sucesso", sim_id);
+    return enxuta ? simulacao_generica_enxuta : simulacao_generica;
+}
+
+bool simulacao_especializada(void) {
+    return selecionar_simulacao(DECKS, NUM_JOGADORES, false) != simulacao_generica;
+}
+
+// Forçar o núcleo completo (comparação de desempenho); definido antes das threads
+static bool nucleo_completo_forcado = false;
+
+void simulacao_set_nucleo_completo(bool forcar) {
+    nucleo_completo_forcado = forcar;
+}
+
+bool simulacao_nucleo_enxuto(int log_level, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis) {
+    return !nucleo_completo_forcado && log_level <= 0 && !dealer_analysis && !freq_analysis_26 && !freq_analysis_70 &&
+           !freq_analysis_A && !split_analysis && !ev_realtime_enabled && !insurance_analysis;
+}
+
+void simulacao_completa(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis, uint64_t rng_seed_base, bool lazy_shuffle) {
+    bool enxuta = simulacao_nucleo_enxuto(log_level, dealer_analysis, freq_analysis_26, freq_analysis_70, freq_analysis_A, split_analysis, ev_realtime_enabled, insurance_analysis);
+    selecionar_simulacao(DECKS, NUM_JOGADORES, enxuta)(log_level, sim_id, output_suffix, global_log_count, dealer_analysis, freq_analysis_26, freq_analysis_70, freq_analysis_A, split_analysis, ev_realtime_enabled, insurance_analysis, rng_seed_base, lazy_shuffle);
 }
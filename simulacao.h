@@ -4,7 +4,99 @@
 #include <stdatomic.h>
 #include <stdbool.h>
 #include <pthread.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "jogo.h"
+#include "estatistica_online.h"
 
-void simulacao_completa(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, pthread_mutex_t* dealer_mutex, pthread_mutex_t* freq_mutex, pthread_mutex_t* split_mutex, bool insurance_analysis, pthread_mutex_t* insurance_mutex);
+void simulacao_completa(int log_level, int sim_id, const char* output_suffix, atomic_int* global_log_count, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis, uint64_t rng_seed_base, bool lazy_shuffle);
+
+// Análise de frequência do dealer (-hist26/-hist70/-histA): upcards 2..10 e
+// A (índice 9) x resultado final (17, 18, 19, 20, 21, BJ, BUST) x bin de TC
+#define FREQ_UPCARDS 10
+#define FREQ_FINAIS 7
+
+// Soma os histogramas de frequência da thread nos totais (chamada ao fim de cada worker)
+void simulacao_freq_acumular_thread(void);
+// Totais acumulados: rodadas com o upcard e, destas, as que terminaram em final_idx
+uint64_t simulacao_freq_total(int upcard_idx, int bin);
+uint64_t simulacao_freq_final(int upcard_idx, int final_idx, int bin);
+
+// Análise de splits (-split): pares AA, 1010, 99 ... 22 x upcards 2..10 e A
+// x bin de TC, com as 9 combinações de resultado das duas mãos
+#define SPLIT_PARES 10
+#define SPLIT_UPCARDS 10
+#define SPLIT_COMBINACOES 9
+
+typedef struct {
+    uint64_t splits;
+    uint64_t combinacoes[SPLIT_COMBINACOES];  // LL, WW, PP, LW, LP, WL, WP, PL, PW (mão 1, mão 2)
+    uint64_t cartas;                          // soma das cartas usadas
+    uint64_t cartas_quadrado;                 // soma dos quadrados (desvio padrão)
+} SplitBin;
+
+// Soma os acumuladores de split da thread nos totais (chamada ao fim de cada worker)
+void simulacao_split_acumular_thread(void);
+// Totais acumulados de um bin
+void simulacao_split_bin(int pair_index, int upcard_index, int bin, SplitBin *out);
+
+// Análises com upcard Ás (-dealer, -ins): rodadas com Ás e, destas, as com
+// blackjack do dealer, por bin de TC ou por bin de densidade de cartas de
+// valor 10 (30,0% a 40,1% em bins de 0,1%)
+#define INSURANCE_BINS 101
+#define INSURANCE_MIN_PERMIL 300
+
+typedef struct {
+    uint64_t ases;
+    uint64_t blackjacks;
+} AsBin;
+
+// Soma os contadores de dealer BJ e insurance da thread nos totais (chamada ao fim de cada worker)
+void simulacao_as_acumular_thread(void);
+// Totais acumulados de um bin
+AsBin simulacao_dealer_bj_bin(int tc_bin);
+AsBin simulacao_insurance_bin(int bin);
+
+// Todos os totais acima como um vetor plano de uint64, na ordem: freq total
+// [upcard][bin], freq final [upcard][final][bin], split [par][upcard][bin]
+// [splits, 9 combinações, cartas, cartas²], dealer BJ [bin][ases, blackjacks]
+// e insurance [bin][ases, blackjacks]. Usado pelo arquivo de acumuladores.
+size_t simulacao_totais_num_contadores(void);
+void simulacao_totais_exportar(uint64_t *destino);
+// Soma um vetor no mesmo layout aos totais (merge de execuções)
+void simulacao_totais_somar(const uint64_t *origem);
+
+// Resultado em unidades das simulações de uma thread: soma compensada e
+// distribuição por simulação, sem estado compartilhado durante as rodadas
+typedef struct {
+    SomaCompensada total;
+    EstatisticaOnline por_sim;
+    double minimo_sim;
+    double maximo_sim;
+    uint64_t rodadas;       // rodadas jogadas (taxa de rodadas/segundo)
+    uint64_t rodadas_anuladas; // rodadas em que o shoe acabou no meio (mesas sem reserva)
+} UnidadesThread;
+
+// Combina as unidades de outra thread (redução após o join, em ordem fixa)
+void unidades_combinar(UnidadesThread *destino, const UnidadesThread *origem);
+// Move as unidades acumuladas pela thread atual para destino (chamada ao fim de cada worker)
+void simulacao_unidades_coletar_thread(UnidadesThread *destino);
+
+// true se DECKS/NUM_JOGADORES atuais usam uma instância especializada
+// (6/8 baralhos, 4 a 7 jogadores) em vez do caminho genérico
+bool simulacao_especializada(void);
+
+// true se simulacao_completa, com estas flags, usa o núcleo enxuto: instância
+// sem log, análises nem EV em tempo real, com esses testes eliminados na
+// compilação. Qualquer flag ativa seleciona o núcleo completo.
+bool simulacao_nucleo_enxuto(int log_level, bool dealer_analysis, bool freq_analysis_26, bool freq_analysis_70, bool freq_analysis_A, bool split_analysis, bool ev_realtime_enabled, bool insurance_analysis);
+// Usa sempre o núcleo completo (comparação de desempenho, -full-kernel);
+// chamar antes de iniciar as simulações
+void simulacao_set_nucleo_completo(bool forcar);
+
+// Variante jogada pela thread atual (modo pareado -crn). rampa NULL = rampa
+// padrão; se unidades_por_shoe != NULL, recebe o resultado em unidades de cada
+// shoe (NUM_SHOES posições) das próximas simulações da thread.
+void simulacao_set_variante(const RampaApostas *rampa, double *unidades_por_shoe);
 
 #endif // SIMULACAO_H 
@@ -9,30 +9,12 @@
 #include <string.h>
 #include <unistd.h>
 
-// Constantes unificadas para batch sizes
-#define DEALER_BATCH_SIZE 20000     // Padronizado: 20k simulações por lote
-#define FREQ_BATCH_SIZE 20000       // Padronizado: 20k simulações por lote  
-#define SPLIT_BATCH_SIZE 20000      // Padronizado: 20k simulações por lote
-
 // Constantes para análise
 #define MAX_BINS 130               // -6.5 a 6.5 com bins de 0.1 = 130 bins
 #define BIN_WIDTH 0.1
 #define MIN_TC -6.5
 #define MAX_TC 6.5
 
-// Prefixos para arquivos temporários
-#define DEALER_TEMP_FILE_PREFIX "temp_dealer_bj_batch_"
-#define FREQ_TEMP_FILE_PREFIX "temp_freq_batch_"
-#define SPLIT_TEMP_FILE_PREFIX "temp_split_batch_"
-#define INSURANCE_TEMP_FILE_PREFIX "temp_insurance_batch_"
-#define BINARY_SUFFIX ".bin"
-
-// Buffer sizes seguros
-#define FREQ_BUFFER_SIZE 5000
-#define FREQ_BUFFER_THRESHOLD (FREQ_BUFFER_SIZE - 100)  // Flush antes do overflow
-#define DEALER_BUFFER_SIZE 2000
-#define DEALER_BUFFER_THRESHOLD (DEALER_BUFFER_SIZE - 50)
-
 // Debug system
 extern bool debug_enabled;
 #define DEBUG_PRINT(fmt, ...) do { \
@@ -63,88 +45,6 @@ extern bool debug_enabled;
     } \
 } while(0)
 
-// Estrutura para dados de dealer (12 bytes)
-typedef struct {
-    float true_count;      // 4 bytes
-    int32_t ace_upcard;    // 4 bytes  
-    int32_t dealer_bj;     // 4 bytes
-    uint32_t checksum;     // 4 bytes - para integridade
-} __attribute__((packed)) DealerBinaryRecord;  // 16 bytes total
-
-// Estrutura para dados de frequência (8 bytes)
-typedef struct {
-    float true_count;      // 4 bytes
-    uint32_t checksum;     // 4 bytes - para integridade
-} __attribute__((packed)) FreqBinaryRecord;    // 8 bytes total
-
-// Estrutura para dados de split (48 bytes)
-typedef struct {
-    float true_count;      // 4 bytes
-    // Combinações reais de resultados (não assumir independência)
-    int32_t lose_lose;     // 4 bytes - ambas mãos perderam
-    int32_t win_win;       // 4 bytes - ambas mãos ganharam
-    int32_t push_push;     // 4 bytes - ambas mãos empataram
-    int32_t lose_win;      // 4 bytes - mão1 perdeu, mão2 ganhou
-    int32_t lose_push;     // 4 bytes - mão1 perdeu, mão2 empatou
-    int32_t win_lose;      // 4 bytes - mão1 ganhou, mão2 perdeu
-    int32_t win_push;      // 4 bytes - mão1 ganhou, mão2 empatou
-    int32_t push_lose;     // 4 bytes - mão1 empatou, mão2 perdeu
-    int32_t push_win;      // 4 bytes - mão1 empatou, mão2 ganhou
-    int32_t cards_used;    // 4 bytes - cartas usadas
-    uint32_t checksum;     // 4 bytes - para integridade
-} __attribute__((packed)) SplitBinaryRecord;   // 48 bytes total
-
-// Estrutura para dados de insurance (12 bytes)
-typedef struct {
-    float ten_cards_percentage; // 4 bytes - porcentagem de cartas de rank 10 (10,J,Q,K) no shoe
-    int32_t dealer_blackjack; // 4 bytes - 1 se dealer tem blackjack, 0 caso contrário
-    uint32_t checksum;     // 4 bytes - para integridade
-} __attribute__((packed)) InsuranceBinaryRecord;  // 12 bytes total
-
-// Funções de utilidade para checksum (safe para strict aliasing)
-static inline uint32_t calculate_dealer_checksum(const DealerBinaryRecord* record) {
-    uint32_t checksum = 0;
-    uint32_t float_as_uint;
-    memcpy(&float_as_uint, &record->true_count, sizeof(float));
-    checksum ^= float_as_uint;
-    checksum ^= (uint32_t)record->ace_upcard;
-    checksum ^= (uint32_t)record->dealer_bj;
-    return checksum;
-}
-
-static inline uint32_t calculate_freq_checksum(const FreqBinaryRecord* record) {
-    uint32_t float_as_uint;
-    memcpy(&float_as_uint, &record->true_count, sizeof(float));
-    return float_as_uint;
-}
-
-static inline uint32_t calculate_split_checksum(const SplitBinaryRecord* record) {
-    uint32_t checksum = 0;
-    uint32_t float_as_uint;
-    memcpy(&float_as_uint, &record->true_count, sizeof(float));
-    checksum ^= float_as_uint;
-    checksum ^= (uint32_t)record->lose_lose;
-    checksum ^= (uint32_t)record->win_win;
-    checksum ^= (uint32_t)record->push_push;
-    checksum ^= (uint32_t)record->lose_win;
-    checksum ^= (uint32_t)record->lose_push;
-    checksum ^= (uint32_t)record->win_lose;
-    checksum ^= (uint32_t)record->win_push;
-    checksum ^= (uint32_t)record->push_lose;
-    checksum ^= (uint32_t)record->push_win;
-    checksum ^= (uint32_t)record->cards_used;
-    return checksum;
-}
-
-static inline uint32_t calculate_insurance_checksum(const InsuranceBinaryRecord* record) {
-    uint32_t checksum = 0;
-    uint32_t float_as_uint;
-    memcpy(&float_as_uint, &record->ten_cards_percentage, sizeof(float));
-    checksum ^= float_as_uint;
-    checksum ^= (uint32_t)record->dealer_blackjack;
-    return checksum;
-}
-
 // Função robusta para cálculo de bins
 static inline int get_bin_index_robust(double true_count) {
     DEBUG_STATS("Calculando bin para TC=%.6f", true_count);
@@ -174,162 +74,6 @@ static inline int get_bin_index_robust(double true_count) {
     return bin_idx;
 }
 
-// Funções de validação
-static inline bool validate_dealer_record(const DealerBinaryRecord* record) {
-    if (!record) return false;
-    
-    // Verificar checksum
-    uint32_t expected_checksum = calculate_dealer_checksum(record);
-    if (record->checksum != expected_checksum) {
-        DEBUG_STATS("Checksum inválido para dealer record: esperado=%u, encontrado=%u", 
-                   expected_checksum, record->checksum);
-        return false;
-    }
-    
-    // Verificar ranges
-    if (record->true_count < -15.0 || record->true_count > 15.0) {
-        DEBUG_STATS("True count inválido: %.3f", record->true_count);
-        return false;
-    }
-    
-    if (record->ace_upcard != 0 && record->ace_upcard != 1) {
-        DEBUG_STATS("Ace upcard inválido: %d", record->ace_upcard);
-        return false;
-    }
-    
-    if (record->dealer_bj != 0 && record->dealer_bj != 1) {
-        DEBUG_STATS("Dealer BJ inválido: %d", record->dealer_bj);
-        return false;
-    }
-    
-    return true;
-}
-
-static inline bool validate_freq_record(const FreqBinaryRecord* record) {
-    if (!record) return false;
-    
-    // Verificar checksum
-    uint32_t expected_checksum = calculate_freq_checksum(record);
-    if (record->checksum != expected_checksum) {
-        DEBUG_STATS("Checksum inválido para freq record: esperado=%u, encontrado=%u", 
-                   expected_checksum, record->checksum);
-        return false;
-    }
-    
-    // Verificar ranges
-    if (record->true_count < -15.0 || record->true_count > 15.0) {
-        DEBUG_STATS("True count inválido: %.3f", record->true_count);
-        return false;
-    }
-    
-    return true;
-}
-
-static inline bool validate_split_record(const SplitBinaryRecord* record) {
-    if (!record) return false;
-    
-    // Verificar checksum
-    uint32_t expected_checksum = calculate_split_checksum(record);
-    if (record->checksum != expected_checksum) {
-        DEBUG_STATS("Checksum inválido para split record: esperado=%u, encontrado=%u", 
-                   expected_checksum, record->checksum);
-        return false;
-    }
-    
-    // Verificar ranges básicos
-    if (record->true_count < -15.0 || record->true_count > 15.0) {
-        DEBUG_STATS("True count inválido: %.3f", record->true_count);
-        return false;
-    }
-    
-    if (record->cards_used < 4 || record->cards_used > 20) {
-        DEBUG_STATS("Cards used inválido: %d", record->cards_used);
-        return false;
-    }
-    
-    // Verificar se todos os campos de combinação são 0 ou 1 (sem usar ponteiros)
-    int32_t combinations[9] = {
-        record->lose_lose, record->win_win, record->push_push,
-        record->lose_win, record->lose_push, record->win_lose,
-        record->win_push, record->push_lose, record->push_win
-    };
-    
-    int total_combinations = 0;
-    for (int i = 0; i < 9; i++) {
-        if (combinations[i] < 0 || combinations[i] > 1) {
-            DEBUG_STATS("Combinação %d inválida: %d", i, combinations[i]);
-            return false;
-        }
-        total_combinations += combinations[i];
-    }
-    
-    // Exatamente uma combinação deve ser 1
-    if (total_combinations != 1) {
-        DEBUG_STATS("Total de combinações inválido: %d (deve ser 1)", total_combinations);
-        return false;
-    }
-    
-    return true;
-}
-
-static inline bool validate_insurance_record(const InsuranceBinaryRecord* record) {
-    if (!record) return false;
-    
-    // Verificar checksum
-    uint32_t expected_checksum = calculate_insurance_checksum(record);
-    if (record->checksum != expected_checksum) {
-        DEBUG_STATS("Checksum inválido para insurance record: esperado=%u, encontrado=%u", 
-                   expected_checksum, record->checksum);
-        return false;
-    }
-    
-    // Validar porcentagem de cartas de rank 10 (0% a 100%)
-    if (record->ten_cards_percentage < 0.0f || record->ten_cards_percentage > 1.0f) {
-        DEBUG_STATS("Porcentagem de cartas de rank 10 inválida: %.6f", record->ten_cards_percentage);
-        return false;
-    }
-    
-    // Validar flag de blackjack (0 ou 1)
-    if (record->dealer_blackjack != 0 && record->dealer_blackjack != 1) {
-        DEBUG_STATS("Flag de blackjack inválida: %d", record->dealer_blackjack);
-        return false;
-    }
-    
-    return true;
-}
-
-// Função para verificar integridade de arquivo
-static inline bool verify_file_integrity(const char* filename, size_t expected_record_size) {
-    DEBUG_IO("Verificando integridade do arquivo: %s", filename);
-    
-    FILE* file = fopen(filename, "rb");
-    if (!file) {
-        DEBUG_IO("Não foi possível abrir arquivo: %s", filename);
-        return false;
-    }
-    
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fclose(file);
-    
-    if (file_size < 0) {
-        DEBUG_IO("Erro ao obter tamanho do arquivo: %s", filename);
-        return false;
-    }
-    
-    if (file_size % expected_record_size != 0) {
-        DEBUG_IO("Arquivo %s tem tamanho incompatível: %ld bytes, esperado múltiplo de %zu", 
-                filename, file_size, expected_record_size);
-        return false;
-    }
-    
-    long num_records = file_size / expected_record_size;
-    DEBUG_IO("Arquivo %s verificado: %ld registros de %zu bytes cada", 
-            filename, num_records, expected_record_size);
-    
-    return true;
-}
-
 // =============================================================================
 // SISTEMA DE MEMORY POOLS OTIMIZADO
 // =============================================================================
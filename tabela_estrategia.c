@@ -1,8 +1,11 @@
 #include "tabela_estrategia.h"
+#include "fsm_mao.h"
+#include "mao_bits.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #define H  ACAO_HIT
 #define S  ACAO_STAND
@@ -75,23 +78,9 @@ AcaoEstrategia estrategia_par(int par_rank, int upcard) {
     return pair_table[par_rank - 2][upcard - 2];
 }
 
-// AcaoEstrategia estrategia_par(int par_rank, int upcard) {
-    
-//     // Tabela de pares 2-A inline para evitar duplicação
-//     static const AcaoEstrategia pair_table[10][10] = {
-//         /*2,2*/ { PH,PH,PH,PH,PH,PH,PH,PH,PH,PH },
-//         /*3,3*/ { PH,PH,PH,PH,PH,PH,PH,PH,PH,PH },
-//         /*4,4*/ { PH,PH,PH,PH,PH,PH,PH,PH,PH,PH},
-//         /*5,5*/ { PH,PH,PH,PH,PH,PH,PH,PH,PH,PH },
-//         /*6,6*/ { PH,PS,PS,PS,PS,PH,PH,PH,PH,PH },
-//         /*7,7*/ { PS,PS,PS,PS,PS,PH,PH,PH,PH,PH },
-//         /*8,8*/ {  PS,PS,PS,PS,PS,PH,PH,PH,PH,PH },
-//         /*9,9*/ {  PS,PS,PS,PS,PS,PS,PS,PS,PS,PS },
-//         /*10,10*/{ PS,PS,PS,PS,PS,PS,PS,PS,PS,PS },
-//         /*A,A*/{ PS,PS,PS,PS,PS,PS,PS,PS,PS,PS }
-//     };
-//     return pair_table[par_rank - 2][upcard - 2];
-// }
+// A tabela de pares alternativa (split em quase todas as upcards) está em
+// Estrategias/pares_agressivos.txt; use -estrategia para carregá-la.
+
 // ========== TABELA DE CHAVES REMOVIDA ==========
 // A tabela estrategia_basica_chaves[] foi removida pois não era utilizada.
 // O sistema usa diretamente as funções estrategia_hard/soft/par() com tabelas inline.
@@ -108,43 +97,14 @@ AcaoEstrategia estrategia_basica_super_rapida(uint64_t mao_bits, int dealer_up_r
     // Versão super-otimizada da estratégia básica
     // Usa lookups diretos eliminando conversões desnecessárias
     
-    // Calcular valor, tipo e rank simultaneamente para máxima eficiência
-    int valor = 0;
-    int ases = 0;
-    int total_cartas = 0;
+    // Valor, soft e par direto dos campos da mão (kernels SWAR de mao_bits.h)
+    int valor = mao_bits_valor(mao_bits);
+    int total_cartas = mao_bits_num_cartas(mao_bits);
+    int ases_soft = mao_bits_soft(mao_bits);
     int pair_rank = -1;
-    
-    // Loop único para calcular tudo
-    for (int idx = 0; idx < 13; ++idx) {
-        uint64_t count = (mao_bits >> (idx * 3)) & 0x7ULL;
-        if (count == 0) continue;
-        
-        total_cartas += (int)count;
-        
-        if (idx <= 7) { // 2 a 9
-            valor += (idx + 2) * count;
-            if (count == 2 && total_cartas == 2) {
-                pair_rank = idx + 2;
-            }
-        } else if (idx <= 11) { // 10, J, Q, K
-            valor += 10 * count;
-            if (count == 2 && total_cartas == 2) {
-                pair_rank = 10;
-            }
-        } else { // Ás
-            ases += (int)count;
-            if (count == 2 && total_cartas == 2) {
-                pair_rank = 11;
-            }
-        }
-    }
-    
-    // Ajustar valor dos ases
-    valor += ases * 11;
-    int ases_soft = ases;
-    while (valor > 21 && ases_soft > 0) {
-        valor -= 10;
-        --ases_soft;
+    int par_idx = mao_bits_par_rank_idx(mao_bits);
+    if (par_idx >= 0) {
+        pair_rank = par_idx <= 7 ? par_idx + 2 : (par_idx <= 11 ? 10 : 11);
     }
     
     // Dealer up ajustado para índice (2-11 -> 0-9)
@@ -167,5 +127,148 @@ AcaoEstrategia estrategia_basica_super_rapida(uint64_t mao_bits, int dealer_up_r
     }
 }
 
+// Tabela plana estado x dealer: a ação de cada estado do autômato de mãos
+// (fsm_mao.h) para cada upcard 2..11, gerada a partir das tabelas hard/soft/par
+// com as mesmas regras de estrategia_basica_super_rapida. Uma decisão é uma
+// leitura de byte: tabela[estado][dealer_up_rank - 2].
+static uint8_t ESTRATEGIA_FLAT[FSM_NUM_ESTADOS][10] __attribute__((aligned(64)));
+static bool estrategia_flat_pronta = false;
+
+// Tabela em uso: a da thread (ex.: variante de -crn) ou a padrão do processo
+// (-estrategia). Ambas apontam para tabelas compiladas e imutáveis.
+static const uint8_t (*tabela_padrao)[10] = (const uint8_t (*)[10])ESTRATEGIA_FLAT;
+static __thread const uint8_t (*tabela_thread)[10] = NULL;
+
+ClasseEstrategia estrategia_classe_estado(uint16_t estado, int *valor) {
+    const FsmAtributos *a = fsm_atributos(estado);
+    if (a->par_rank >= 0) {
+        // Índice de rank -> valor do par (2..9, T/J/Q/K = 10, A = 11)
+        *valor = a->par_rank <= 7 ? a->par_rank + 2 : (a->par_rank <= 11 ? 10 : 11);
+        return CLASSE_PAR;
+    }
+    *valor = a->valor;
+    return ((a->flags & FSM_SOFT) && a->num_cartas == 2) ? CLASSE_SOFT : CLASSE_HARD;
+}
+
+void estrategia_tabelas_embutidas(TabelasEstrategia *t) {
+    for (int d = 0; d < 10; ++d) {
+        for (int valor = 3; valor <= 21; ++valor) t->hard[valor - 3][d] = (uint8_t)estrategia_hard(valor, d + 2);
+        for (int valor = 13; valor <= 21; ++valor) t->soft[valor - 13][d] = (uint8_t)estrategia_soft(valor, d + 2);
+        for (int par = 2; par <= 11; ++par) t->par[par - 2][d] = (uint8_t)estrategia_par(par, d + 2);
+    }
+}
+
+void estrategia_compilar(const TabelasEstrategia *t, uint8_t (*tabela)[10]) {
+    for (int estado = 0; estado < FSM_NUM_ESTADOS; ++estado) {
+        int valor;
+        ClasseEstrategia classe = estrategia_classe_estado((uint16_t)estado, &valor);
+        for (int d = 0; d < 10; ++d) {
+            uint8_t acao = ACAO_HIT;
+            if (classe == CLASSE_PAR) {
+                acao = t->par[valor - 2][d];
+            } else if (classe == CLASSE_SOFT) {
+                if (valor >= 13 && valor <= 21) acao = t->soft[valor - 13][d];
+            } else if (valor >= 3 && valor <= 21) {
+                acao = t->hard[valor - 3][d];
+            }
+            tabela[estado][d] = acao;
+        }
+    }
+}
+
+int estrategia_num_estados(void) {
+    return FSM_NUM_ESTADOS;
+}
+
+void estrategia_flat_inicializar(void) {
+    if (estrategia_flat_pronta) return;
+    TabelasEstrategia embutidas;
+    estrategia_tabelas_embutidas(&embutidas);
+    estrategia_compilar(&embutidas, ESTRATEGIA_FLAT);
+    estrategia_flat_pronta = true;
+}
+
+void estrategia_set_padrao(const uint8_t (*tabela)[10]) {
+    tabela_padrao = tabela ? tabela : (const uint8_t (*)[10])ESTRATEGIA_FLAT;
+}
+
+void estrategia_set_thread(const uint8_t (*tabela)[10]) {
+    tabela_thread = tabela;
+}
+
+AcaoEstrategia estrategia_basica_estado(uint16_t estado, int dealer_up_rank) {
+    unsigned dealer_idx = (unsigned)(dealer_up_rank - 2);
+    if (dealer_idx > 9) return ACAO_HIT;
+    const uint8_t (*tabela)[10] = tabela_thread ? tabela_thread : tabela_padrao;
+    return (AcaoEstrategia)tabela[estado][dealer_idx];
+}
+
+int estrategia_ler_acao(const char *texto, AcaoEstrategia *acao) {
+    static const struct { const char *codigo; AcaoEstrategia acao; } codigos[] = {
+        {"H", ACAO_HIT}, {"S", ACAO_STAND}, {"D", ACAO_DOUBLE}, {"DH", ACAO_DOUBLE_OR_HIT},
+        {"DS", ACAO_DOUBLE_OR_STAND}, {"P", ACAO_SPLIT}, {"PH", ACAO_SPLIT_OR_HIT},
+        {"PS", ACAO_SPLIT_OR_STAND},
+    };
+    for (size_t i = 0; i < sizeof(codigos) / sizeof(codigos[0]); ++i) {
+        if (strcmp(texto, codigos[i].codigo) == 0) {
+            *acao = codigos[i].acao;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Validação exaustiva: toda mão alcançável (multiconjuntos não estourados com
+// até MAO_MAX_POR_RANK (15, campos de 4 bits) cartas por rank, mais a carta
+// seguinte, inclusive as que estouram)
+// contra estrategia_basica_super_rapida para cada upcard 2..11.
+static const int VALOR_DURO_RANK[13] = {2, 3, 4, 5, 6, 7, 8, 9, 10, 10, 10, 10, 1};
+
+static long validar_mao(uint64_t bits, uint16_t estado) {
+    long divergencias = 0;
+    for (int up = 2; up <= 11; ++up) {
+        AcaoEstrategia esperada = estrategia_basica_super_rapida(bits, up);
+        AcaoEstrategia obtida = (AcaoEstrategia)ESTRATEGIA_FLAT[estado][up - 2];
+        if (esperada != obtida) {
+            if (divergencias == 0) {
+                fprintf(stderr, "Tabela plana diverge: bits=%llx estado=%u dealer=%d (%d vs %d)\n",
+                        (unsigned long long)bits, estado, up, obtida, esperada);
+            }
+            divergencias++;
+        }
+    }
+    return divergencias;
+}
+
+static long validar_recursivo(int contagem[13], int rank_min, uint64_t bits, uint16_t estado,
+                              int total, long *maos) {
+    long divergencias = validar_mao(bits, estado);
+    (*maos)++;
+    for (int rank = 0; rank < 13; ++rank) {
+        if (contagem[rank] >= MAO_MAX_POR_RANK) continue;
+        int novo_total = total + VALOR_DURO_RANK[rank];
+        uint64_t novos_bits = bits + mao_bits_carta(rank);
+        uint16_t prox = fsm_proximo(estado, rank);
+        contagem[rank]++;
+        if (novo_total > 21) {
+            divergencias += validar_mao(novos_bits, prox);
+            (*maos)++;
+        } else if (rank >= rank_min) {
+            divergencias += validar_recursivo(contagem, rank, novos_bits, prox, novo_total, maos);
+        }
+        contagem[rank]--;
+    }
+    return divergencias;
+}
+
+long estrategia_flat_validar(long *maos_verificadas) {
+    int contagem[13] = {0};
+    long maos = 0;
+    estrategia_flat_inicializar();
+    long divergencias = validar_recursivo(contagem, 0, 0, FSM_ESTADO_VAZIO, 0, &maos);
+    if (maos_verificadas) *maos_verificadas = maos;
+    return divergencias;
+}
+
 // As funções estrategia_basica_pura_binaria e tabelas relacionadas foram removidas
 // pois não estão sendo utilizadas no sistema atual 
\ No newline at end of file
@@ -32,6 +32,45 @@ AcaoEstrategia estrategia_par(int par_rank, int dealer_up);
 // Função da estratégia básica SUPER-OTIMIZADA (única função utilizada)
 AcaoEstrategia estrategia_basica_super_rapida(uint64_t mao_bits, int dealer_up_rank);
 
+// Tabela da estratégia básica que decide um estado do autômato de mãos:
+// par de 2 cartas (valor = 2..11), soft de 2 cartas ou hard (valor da mão)
+typedef enum {
+    CLASSE_HARD = 0,
+    CLASSE_SOFT,
+    CLASSE_PAR
+} ClasseEstrategia;
+
+ClasseEstrategia estrategia_classe_estado(uint16_t estado, int *valor);
+
+// Tabela plana estado x dealer (estado = id do autômato de mãos, fsm_mao.h).
+// Deve ser inicializada uma vez antes do uso (main, antes das threads).
+void estrategia_flat_inicializar(void);
+AcaoEstrategia estrategia_basica_estado(uint16_t estado, int dealer_up_rank);
+// Compara a tabela embutida com estrategia_basica_super_rapida em toda mão
+// alcançável; retorna o nº de divergências
+long estrategia_flat_validar(long *maos_verificadas);
+
+// Tabelas de estratégia no formato de edição (upcards 2..10, A nas colunas)
+typedef struct {
+    uint8_t hard[19][10];   // totais 3..21
+    uint8_t soft[9][10];    // A,2..A,10 (13..21, duas cartas)
+    uint8_t par[10][10];    // 2,2..10,10 e A,A
+} TabelasEstrategia;
+
+void estrategia_tabelas_embutidas(TabelasEstrategia *t);
+// Compila as tabelas na forma plana (estrategia_num_estados() linhas x 10)
+void estrategia_compilar(const TabelasEstrategia *t, uint8_t (*tabela)[10]);
+int estrategia_num_estados(void);
+
+// Troca da tabela compilada em uso, sem custo de parsing: a padrão do
+// processo (antes das threads; NULL = embutida) ou a da thread atual
+// (NULL = volta à padrão)
+void estrategia_set_padrao(const uint8_t (*tabela)[10]);
+void estrategia_set_thread(const uint8_t (*tabela)[10]);
+
+// Códigos de ação dos arquivos de estratégia/desvios: H, S, D, DH, DS, P, PH, PS
+int estrategia_ler_acao(const char *texto, AcaoEstrategia *acao);
+
 // NOTA: buscar_estrategia_por_chave() foi removida pois não era utilizada
 
 #ifdef __cplusplus